@@ -0,0 +1,800 @@
+#include "NeuralNetwork.h"
+#include "PopulationNeuralNetwork.h"
+#include "SparseNeuralNetwork.h"
+#include "FixedNeuralNetwork.h"
+#include "GeneticAlgorithm.h"
+#include "FitnessCache.h"
+#include "RacingEvaluator.h"
+#include "Dataset.h"
+#include "LAFileIO.h"
+#include "Random.h"
+#include "SimdKernel.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <thread>
+#include <filesystem>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include <cstdio>
+
+/*
+* vȏ̑x𑪂x`}[N
+*
+* g
+*     LearningAlgorithmBenchmark [--quick] [--filter ] [--time b] [--repeat ]
+*                                [--output .json] [--baseline .json] [--threshold ]
+*
+*     --quick     傫\Ȃ
+*     --filter    Oɕ܂ނ̂
+*     --time      P̌vōŒ񂷎 ( 0.2b)
+*     --repeat    v̉ (lʂɂ  5)
+*     --output    ʂJSONŏo
+*     --baseline  ȑOɏoJSONƔׁAthresholdxȂ̂ΏIR[h1Ԃ
+*     --threshold xȂƂ݂Ȃ ( 0.05 = 5%)
+*
+* ̃V[h͌ŒȂ̂ŁAœ́Ed݁E̂ɑ΂đ
+*/
+
+namespace
+{
+	constexpr uint64_t SEED = 20240101;
+
+	// ̐ * F̂̒𒴂\͑Ȃ (ȂȂ邽)
+	constexpr int64_t MAX_GENE_NUM = int64_t(1) << 24;
+
+	struct Options
+	{
+		bool quick = false;
+		std::string filter;
+		double time = 0.2;
+		int repeat = 5;
+		std::string output;
+		std::string baseline;
+		double threshold = 0.05;
+	};
+
+	struct Result
+	{
+		std::string name;
+		std::string unit;
+		double value = 0;
+		bool higherIsBetter = true;
+	};
+
+	template<typename T>
+	const char* typeName()
+	{
+		if constexpr (std::is_same_v<T, int>)
+			return "int";
+		else if constexpr (std::is_same_v<T, float>)
+			return "float";
+		else
+			return "double";
+	}
+
+	const char* simdName(SimdLevel level)
+	{
+		switch (level)
+		{
+		case SimdLevel::AVX2:
+			return "AVX2";
+		case SimdLevel::AVX512:
+			return "AVX512";
+		default:
+			return "SCALAR";
+		}
+	}
+
+	std::string topologyName(const std::vector<int>& topology)
+	{
+		std::string name;
+		for (size_t i = 0; i < topology.size(); ++i)
+			name += (i == 0 ? "" : "-") + std::to_string(topology[i]);
+		return name;
+	}
+
+	class Benchmark
+	{
+	public:
+		explicit Benchmark(const Options& options)
+			: m_options(options)
+			, m_results()
+		{
+		}
+
+		// @return name𑪂ꍇtrue
+		bool enabled(const std::string& name) const
+		{
+			return m_options.filter.empty() || name.find(m_options.filter) != std::string::npos;
+		}
+
+		/*
+		* functionJԂĂсAPb̎dʂ̒l߂
+		*
+		* @param function 鏈
+		* @param work     functionPĂ񂾂Ƃ̎d
+		* @return Pb̎d
+		*/
+		double measure(const std::function<void()>& function, double work) const
+		{
+			using Clock = std::chrono::steady_clock;
+
+			// 1̌vtime / repeatȏɂȂ񐔂߂ (EH[Abv˂)
+			const double target = m_options.time / m_options.repeat;
+			int64_t iteration = 1;
+			while (true)
+			{
+				auto begin = Clock::now();
+				for (int64_t i = 0; i < iteration; ++i)
+					function();
+				double elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+				if (elapsed >= target)
+					break;
+				iteration = elapsed > 0 ? std::max(iteration * 2, static_cast<int64_t>(iteration * target / elapsed * 1.2)) : iteration * 2;
+			}
+
+			std::vector<double> rates;
+			for (int r = 0; r < m_options.repeat; ++r)
+			{
+				auto begin = Clock::now();
+				for (int64_t i = 0; i < iteration; ++i)
+					function();
+				double elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+				rates.push_back(work * iteration / elapsed);
+			}
+			std::sort(rates.begin(), rates.end());
+			return rates[rates.size() / 2];
+		}
+
+		void add(const std::string& name, const std::string& unit, double value, bool higherIsBetter = true)
+		{
+			m_results.push_back({ name, unit, value, higherIsBetter });
+			std::cout << std::left << std::setw(56) << name << std::right << std::setw(16) << std::setprecision(6) << value << " " << unit << std::endl;
+		}
+
+		const std::vector<Result>& getResults() const
+		{
+			return m_results;
+		}
+
+		const Options& getOptions() const
+		{
+			return m_options;
+		}
+
+	private:
+		Options m_options;
+		std::vector<Result> m_results;
+	};
+
+	template<typename T>
+	void createNeuralNetwork(NeuralNetwork<T>& nn, const std::vector<int>& topology)
+	{
+		nn.setInputLayer(topology.front());
+		nn.setHiddenLayerNum(static_cast<int>(topology.size()) - 2);
+		for (size_t i = 1; i + 1 < topology.size(); ++i)
+			nn.setHiddenLayer(topology[i], ActFncID::RELU);
+		nn.setOutputLayer(topology.back(), ActFncID::IDENTITY);
+
+		Random random(SEED);
+		if constexpr (std::is_floating_point_v<T>)
+			nn.setWeightRandom(T(-0.5), T(0.5), random);
+		else
+			nn.setWeightRandom(-9, 9, random);
+	}
+
+	template<typename T>
+	std::vector<T> createInput(int size)
+	{
+		std::vector<T> input(size);
+		Random random(SEED, 1);
+		if constexpr (std::is_floating_point_v<T>)
+			random.fill(input.data(), size, T(-1), T(1));
+		else
+			random.fill(input.data(), size, 0, 1);
+		return input;
+	}
+
+	// NeuralNetwork::forwardPropagation (܂Ƃ߂ď`d)
+	template<typename T>
+	void benchmarkForward(Benchmark& benchmark, const std::vector<std::vector<int>>& topologies)
+	{
+		constexpr int SAMPLE_NUM = 256;
+		for (const auto& topology : topologies)
+		{
+			const std::string name = std::string("forward/") + typeName<T>() + "/" + topologyName(topology);
+			if (!benchmark.enabled(name))
+				continue;
+
+			NeuralNetwork<T> nn;
+			createNeuralNetwork(nn, topology);
+			std::vector<T> input = createInput<T>(SAMPLE_NUM * nn.getInputLayerSize());
+			std::vector<T> output(SAMPLE_NUM * nn.getOutputLayerSize());
+
+			double samples = benchmark.measure([&]() { nn.forwardPropagation(input.data(), SAMPLE_NUM, output.data()); }, SAMPLE_NUM);
+			benchmark.add(name + "/samples", "samples/s", samples);
+			benchmark.add(name + "/weight", "ns/weight", 1e9 / (samples * nn.getWeightSize()), false);
+		}
+	}
+
+	// SparseNeuralNetwork::forwardPropagation (}肵d݂ŏ`d)
+	template<typename T>
+	void benchmarkSparseForward(Benchmark& benchmark, const std::vector<std::vector<int>>& topologies, const std::vector<double>& sparsities)
+	{
+		constexpr int SAMPLE_NUM = 256;
+		for (const auto& topology : topologies)
+		{
+			for (double sparsity : sparsities)
+			{
+				for (SparseFormat format : { SparseFormat::CSR, SparseFormat::BLOCK })
+				{
+					const std::string name = std::string("sparse/") + typeName<T>() + "/" + topologyName(topology)
+						+ (format == SparseFormat::CSR ? "/csr" : "/block") + std::to_string(static_cast<int>(sparsity * 100));
+					if (!benchmark.enabled(name))
+						continue;
+
+					NeuralNetwork<T> nn;
+					createNeuralNetwork(nn, topology);
+					SparseNeuralNetwork<T> snn;
+					snn.prune(nn, SparseNeuralNetwork<T>::getPruneThreshold(nn, sparsity), format);
+					std::vector<T> input = createInput<T>(SAMPLE_NUM * nn.getInputLayerSize());
+					std::vector<T> output(SAMPLE_NUM * nn.getOutputLayerSize());
+
+					double samples = benchmark.measure([&]() { snn.forwardPropagation(input.data(), SAMPLE_NUM, output.data()); }, SAMPLE_NUM);
+					benchmark.add(name + "/samples", "samples/s", samples);
+					benchmark.add(name + "/bytes", "bytes", static_cast<double>(snn.getByteSize()), false);
+				}
+			}
+		}
+	}
+
+	// FixedNeuralNetwork::forwardPropagation (NeuralNetworkƓd݂̏NNP͂`d)
+	template<typename T, typename Fixed>
+	void benchmarkFixedForward(Benchmark& benchmark, const std::vector<int>& topology)
+	{
+		constexpr int SAMPLE_NUM = 256;
+		const std::string name = std::string("fixed/") + typeName<T>() + "/" + topologyName(topology);
+		if (!benchmark.enabled(name))
+			return;
+
+		NeuralNetwork<T> nn;
+		createNeuralNetwork(nn, topology);
+		Fixed fnn;
+		fnn.fromNeuralNetwork(nn);
+		std::vector<T> input = createInput<T>(SAMPLE_NUM * nn.getInputLayerSize());
+		std::vector<T> output(SAMPLE_NUM * nn.getOutputLayerSize());
+
+		double fixed = benchmark.measure([&]() { fnn.forwardPropagation(input.data(), SAMPLE_NUM, output.data()); }, SAMPLE_NUM);
+		double dynamic = benchmark.measure([&]()
+			{
+				for (int s = 0; s < SAMPLE_NUM; ++s)
+					nn.forwardPropagation(&input[s * nn.getInputLayerSize()]);
+			}, SAMPLE_NUM);
+		benchmark.add(name + "/fixed", "samples/s", fixed);
+		benchmark.add(name + "/dynamic", "samples/s", dynamic);
+	}
+
+	// ̂Ƃɏd݂ݒ肵ď`d (NeuralNetwork::setWeightŃRs[ꍇbindWeightŎ؂ꍇ)
+	template<typename T>
+	void benchmarkBindWeight(Benchmark& benchmark, const std::vector<std::vector<int>>& topologies, int population)
+	{
+		for (const auto& topology : topologies)
+		{
+			const std::string name = std::string("bind/") + typeName<T>() + "/" + topologyName(topology) + "/pop" + std::to_string(population);
+			if (!benchmark.enabled(name))
+				continue;
+
+			NeuralNetwork<T> nn;
+			createNeuralNetwork(nn, topology);
+			if (static_cast<int64_t>(population) * nn.getWeightSize() > MAX_GENE_NUM)
+				continue;
+			const int weightSize = nn.getWeightSize();
+			std::vector<T> individuals = createInput<T>(population * weightSize);
+			std::vector<T> input = createInput<T>(nn.getInputLayerSize());
+
+			double copy = benchmark.measure([&]()
+				{
+					for (int i = 0; i < population; ++i)
+					{
+						nn.setWeight(&individuals[i * weightSize]);
+						nn.forwardPropagation(input.data());
+					}
+				}, population);
+			double bind = benchmark.measure([&]()
+				{
+					for (int i = 0; i < population; ++i)
+					{
+						nn.bindWeight(std::span<const T>(&individuals[i * weightSize], weightSize));
+						nn.forwardPropagation(input.data());
+					}
+				}, population);
+			benchmark.add(name + "/copy", "individuals/s", copy);
+			benchmark.add(name + "/bind", "individuals/s", bind);
+		}
+	}
+
+	// PopulationNeuralNetwork::forwardPropagation (S̂܂Ƃ߂ď`d)
+	template<typename T>
+	void benchmarkPopulationForward(Benchmark& benchmark, const std::vector<std::vector<int>>& topologies, const std::vector<int>& populations)
+	{
+		constexpr int SAMPLE_NUM = 16;
+		for (const auto& topology : topologies)
+		{
+			for (int population : populations)
+			{
+				const std::string name = std::string("population/") + typeName<T>() + "/" + topologyName(topology) + "/pop" + std::to_string(population);
+				if (!benchmark.enabled(name))
+					continue;
+
+				NeuralNetwork<T> nn;
+				createNeuralNetwork(nn, topology);
+				if (static_cast<int64_t>(population) * nn.getWeightSize() > MAX_GENE_NUM)
+					continue;
+				std::vector<T> individuals = createInput<T>(population * nn.getWeightSize());
+				std::vector<T> input = createInput<T>(SAMPLE_NUM * nn.getInputLayerSize());
+				std::vector<T> output(population * SAMPLE_NUM * nn.getOutputLayerSize());
+
+				PopulationNeuralNetwork<T> pnn;
+				pnn.setStructure(nn);
+				pnn.setIndividuals(individuals.data(), population);
+
+				double samples = benchmark.measure([&]() { pnn.forwardPropagation(input.data(), SAMPLE_NUM, output.data()); }, static_cast<double>(population) * SAMPLE_NUM);
+				benchmark.add(name + "/samples", "samples/s", samples);
+				benchmark.add(name + "/weight", "ns/weight", 1e9 / (samples * nn.getWeightSize()), false);
+			}
+		}
+	}
+
+	// GeneticAlgorithm::generateNextGeneration
+	template<typename Gene>
+	void benchmarkGeneration(Benchmark& benchmark, const std::vector<int>& populations, const std::vector<int>& lengths, const std::vector<int>& threadNums)
+	{
+		for (int population : populations)
+		{
+			for (int length : lengths)
+			{
+				for (int threadNum : threadNums)
+				{
+					const std::string name = std::string("generation/") + typeName<Gene>() + "/pop" + std::to_string(population) + "/len" + std::to_string(length) + "/threads" + std::to_string(threadNum);
+					if (!benchmark.enabled(name) || static_cast<int64_t>(population) * length > MAX_GENE_NUM)
+						continue;
+
+					GeneticAlgorithm<Gene, double> ga;
+					ga.setSeed(SEED);
+					ga.setThreadNum(threadNum);
+					ga.reset(population, length, Gene(-9), Gene(9), 1);
+					ga.setIndividualsRandom(ga.getChromosomeValueMin(), ga.getChromosomeValueMax());
+
+					std::vector<double> fitness = createInput<double>(population);
+					double generations = benchmark.measure([&]()
+						{
+							ga.evaluate(fitness.data());
+							ga.generateNextGeneration();
+						}, 1);
+					benchmark.add(name, "generations/s", generations);
+				}
+			}
+		}
+	}
+
+	// FitnessCache1̑S̂x (JԂ̂ŁA2ڈȍ~͑S̂qbgƂ̑xɂȂ)
+	template<typename Gene>
+	void benchmarkFitnessCache(Benchmark& benchmark, const std::vector<int>& populations, const std::vector<int>& lengths)
+	{
+		for (int population : populations)
+		{
+			for (int length : lengths)
+			{
+				const std::string name = std::string("cache/") + typeName<Gene>() + "/pop" + std::to_string(population) + "/len" + std::to_string(length);
+				if (!benchmark.enabled(name) || static_cast<int64_t>(population) * length > MAX_GENE_NUM)
+					continue;
+
+				GeneticAlgorithm<Gene, double> ga;
+				ga.setSeed(SEED);
+				ga.reset(population, length, Gene(-9), Gene(9), 1);
+				ga.setIndividualsRandom(ga.getChromosomeValueMin(), ga.getChromosomeValueMax());
+
+				FitnessCache<Gene, double> cache;
+				cache.reset(population * 4);
+				std::vector<int> unknown;
+				std::vector<double> fitness(population);
+				double individuals = benchmark.measure([&]()
+					{
+						cache.lookup(ga, fitness.data(), unknown);
+						for (int index : unknown)
+							fitness[index] = index;
+						cache.store(ga, fitness.data(), unknown);
+					}, population);
+				benchmark.add(name, "individuals/s", individuals);
+			}
+		}
+	}
+
+	/*
+	* ̃Tvŕ]P (STv]ꍇRacingEvaluatorőł؂ꍇ)
+	*
+	* F̂`f̌WƂATvƂ̌덷̐ΒlɃ}CiXtēKxɂ
+	*/
+	void benchmarkRacing(Benchmark& benchmark, const std::vector<int>& populations, const std::vector<int>& sampleNums)
+	{
+		constexpr int LENGTH = 16;
+		constexpr int CHUNK_SIZE = 64;
+		for (int population : populations)
+		{
+			for (int sampleNum : sampleNums)
+			{
+				const std::string name = "racing/double/pop" + std::to_string(population) + "/samples" + std::to_string(sampleNum);
+				if (!benchmark.enabled(name))
+					continue;
+
+				std::vector<double> input = createInput<double>(sampleNum * LENGTH);
+				std::vector<double> target(sampleNum);
+				for (int i = 0; i < sampleNum; ++i)
+				{
+					for (int j = 0; j < LENGTH; ++j)
+						target[i] += input[i * LENGTH + j] * (j % 2 == 0 ? 0.5 : -0.25);
+				}
+				auto error = [&](const double* chromosome, int begin, int end)
+				{
+					double sum = 0;
+					for (int i = begin; i < end; ++i)
+					{
+						double output = 0;
+						for (int j = 0; j < LENGTH; ++j)
+							output += chromosome[j] * input[i * LENGTH + j];
+						sum += std::abs(output - target[i]);
+					}
+					return -sum;
+				};
+
+				// Ԃ̏WcŔׂ邽߁Ai߂Wcg
+				GeneticAlgorithm<double, double> ga;
+				ga.setSeed(SEED);
+				ga.reset(population, LENGTH, -1.0, 1.0, std::max(population / 20, 1));
+				ga.setIndividualsRandom(ga.getChromosomeValueMin(), ga.getChromosomeValueMax());
+				RacingEvaluator<double, double> racing;
+				racing.reset(sampleNum, CHUNK_SIZE);
+				for (int generation = 0; generation < 10; ++generation)
+				{
+					racing.evaluate(ga, [&](int, const double* chromosome, int begin, int end) { return error(chromosome, begin, end); });
+					ga.generateNextGeneration();
+				}
+
+				std::vector<double> fitness(population);
+				double full = benchmark.measure([&]()
+					{
+						for (int i = 0; i < population; ++i)
+							fitness[i] = error(ga.getIndividual(i), 0, sampleNum);
+					}, 1);
+				racing.clearStatistics();
+				double race = benchmark.measure([&]()
+					{
+						racing.race(ga, fitness.data(), [&](int, const double* chromosome, int begin, int end) { return error(chromosome, begin, end); });
+					}, 1);
+				benchmark.add(name + "/full", "generations/s", full);
+				benchmark.add(name + "/race", "generations/s", race);
+				benchmark.add(name + "/saved", "%", racing.getStatistics().getSavedRate() * 100);
+			}
+		}
+	}
+
+	// DatasetŃ~job`ɓ鑬x (t@C̏ƕבւ)
+	void benchmarkDataset(Benchmark& benchmark, const std::vector<int>& sampleNums)
+	{
+		constexpr int INPUT_SIZE = 64;
+		constexpr int TARGET_SIZE = 10;
+		constexpr int BATCH_SIZE = 64;
+		const std::string path = (std::filesystem::temp_directory_path() / "LearningAlgorithmBenchmark.ds").string();
+
+		for (int sampleNum : sampleNums)
+		{
+			const std::string name = "dataset/float/samples" + std::to_string(sampleNum);
+			if (!benchmark.enabled(name))
+				continue;
+
+			DatasetWriter<float> writer;
+			std::vector<float> input = createInput<float>(INPUT_SIZE);
+			std::vector<float> target = createInput<float>(TARGET_SIZE);
+			bool written = writer.open(path, sampleNum, INPUT_SIZE, TARGET_SIZE);
+			for (int i = 0; written && i < sampleNum; ++i)
+				written = writer.append(input.data(), target.data());
+			if (!writer.close() || !written)
+				continue;
+
+			Dataset<float> dataset;
+			if (!dataset.open(path))
+				continue;
+			dataset.setSeed(SEED);
+			for (bool shuffle : { false, true })
+			{
+				dataset.setBatch(BATCH_SIZE, shuffle);
+				double samples = benchmark.measure([&]()
+					{
+						dataset.beginEpoch();
+						DatasetBatch<float> batch;
+						while (dataset.nextBatch(batch))
+						{
+						}
+					}, sampleNum);
+				benchmark.add(name + (shuffle ? "/shuffle" : "/sequential"), "samples/s", samples);
+			}
+			dataset.close();
+			std::filesystem::remove(path);
+		}
+	}
+
+	/*
+	* t@C݂̏Ɠǂݍ݂̑x
+	*
+	* @param output pathɏo
+	* @param input  pathǂݍޏ
+	*/
+	void benchmarkFile(Benchmark& benchmark, const std::string& name, const std::string& path, const std::function<void()>& output, const std::function<void()>& input)
+	{
+		output();
+		const double megabytes = std::filesystem::file_size(path) / (1024.0 * 1024.0);
+		benchmark.add(name + "/write", "MB/s", benchmark.measure(output, megabytes));
+		benchmark.add(name + "/read", "MB/s", benchmark.measure(input, megabytes));
+		std::filesystem::remove(path);
+	}
+
+	// LAFileIO̊e`
+	void benchmarkFileIO(Benchmark& benchmark, const std::vector<std::vector<int>>& topologies, const std::vector<int>& populations)
+	{
+		const std::string path = (std::filesystem::temp_directory_path() / "LearningAlgorithmBenchmark.dat").string();
+
+		for (const auto& topology : topologies)
+		{
+			NeuralNetwork<double> nn;
+			createNeuralNetwork(nn, topology);
+			NeuralNetwork<double> nn2;
+
+			const std::string name = "io/nn/" + topologyName(topology);
+			if (benchmark.enabled(name))
+			{
+				benchmarkFile(benchmark, name, path,
+					[&]() { LAFileIO::outputNeuralNetwork(path, nn); },
+					[&]() { LAFileIO::inputNeuralNetwork(path, nn2); });
+			}
+
+			const std::string modelName = "io/model/" + topologyName(topology);
+			if (benchmark.enabled(modelName))
+			{
+				benchmarkFile(benchmark, modelName, path,
+					[&]() { LAFileIO::outputNeuralNetworkModel(path, nn); },
+					[&]() { LAFileIO::inputNeuralNetworkModel(path, nn2); });
+			}
+
+			for (int population : populations)
+			{
+				const std::string gaName = "io/ga/" + topologyName(topology) + "/pop" + std::to_string(population);
+				if (!benchmark.enabled(gaName) || static_cast<int64_t>(population) * nn.getWeightSize() > MAX_GENE_NUM)
+					continue;
+
+				GeneticAlgorithm<double, double> ga;
+				ga.setSeed(SEED);
+				ga.reset(population, nn.getWeightSize(), -1.0, 1.0, 1);
+				ga.setIndividualsRandom(ga.getChromosomeValueMin(), ga.getChromosomeValueMax());
+				GeneticAlgorithm<double, double> ga2;
+
+				benchmarkFile(benchmark, gaName, path,
+					[&]() { LAFileIO::outputGeneticAlgorithm(path, ga); },
+					[&]() { LAFileIO::inputGeneticAlgorithm(path, ga2); });
+			}
+		}
+	}
+
+	std::string escape(const std::string& s)
+	{
+		std::string escaped;
+		for (char c : s)
+		{
+			if (c == '"' || c == '\\')
+				escaped += '\\';
+			escaped += c;
+		}
+		return escaped;
+	}
+
+	/*
+	* ʂJSONŏo
+	*
+	* ʂ͂PsɂP̂ŁAsPʂłrł
+	*/
+	bool writeJson(const std::string& path, const Benchmark& benchmark)
+	{
+		std::ofstream ofs(path);
+		if (!ofs)
+			return false;
+
+		ofs << "{\n";
+		ofs << "  \"schema\": 1,\n";
+		ofs << "  \"seed\": " << SEED << ",\n";
+		ofs << "  \"simd\": \"" << simdName(SimdKernel::getLevel()) << "\",\n";
+		ofs << "  \"hardwareThreads\": " << std::thread::hardware_concurrency() << ",\n";
+		ofs << "  \"quick\": " << (benchmark.getOptions().quick ? "true" : "false") << ",\n";
+		ofs << "  \"results\": [\n";
+		const auto& results = benchmark.getResults();
+		for (size_t i = 0; i < results.size(); ++i)
+		{
+			const Result& result = results[i];
+			ofs << "    {\"name\": \"" << escape(result.name) << "\", \"unit\": \"" << escape(result.unit)
+				<< "\", \"value\": " << std::setprecision(9) << result.value
+				<< ", \"higherIsBetter\": " << (result.higherIsBetter ? "true" : "false") << "}"
+				<< (i + 1 < results.size() ? "," : "") << "\n";
+		}
+		ofs << "  ]\n";
+		ofs << "}\n";
+		return static_cast<bool>(ofs);
+	}
+
+	/*
+	* writeJson֐ŏoJSON猋ʂǂݍ
+	*
+	* "name""value"̑gɏE (ėpJSONp[Tł͂Ȃ)
+	*/
+	bool readJson(const std::string& path, std::map<std::string, double>& values)
+	{
+		std::ifstream ifs(path);
+		if (!ifs)
+			return false;
+
+		std::stringstream ss;
+		ss << ifs.rdbuf();
+		const std::string text = ss.str();
+
+		static const std::string NAME = "\"name\": \"";
+		static const std::string VALUE = "\"value\": ";
+		size_t position = 0;
+		while ((position = text.find(NAME, position)) != std::string::npos)
+		{
+			position += NAME.size();
+			std::string name;
+			while (position < text.size() && text[position] != '"')
+			{
+				if (text[position] == '\\')
+					++position;
+				name += text[position++];
+			}
+
+			size_t value = text.find(VALUE, position);
+			if (value == std::string::npos)
+				return false;
+			values[name] = std::strtod(&text[value + VALUE.size()], nullptr);
+			position = value;
+		}
+		return true;
+	}
+
+	/*
+	* ̌ʂƔׂĕ\
+	*
+	* @return thresholdxȂ̂̐
+	*/
+	int compare(const Benchmark& benchmark, const std::map<std::string, double>& baseline)
+	{
+		const double threshold = benchmark.getOptions().threshold;
+		int regressionNum = 0;
+
+		std::cout << std::endl << std::left << std::setw(56) << "name" << std::right << std::setw(16) << "baseline" << std::setw(16) << "current" << std::setw(10) << "change" << std::endl;
+		for (const Result& result : benchmark.getResults())
+		{
+			auto it = baseline.find(result.name);
+			if (it == baseline.end() || it->second <= 0)
+				continue;
+
+			// Ȃꍇ𐳂ɂ
+			double ratio = result.value / it->second;
+			double change = result.higherIsBetter ? ratio - 1 : 1 / ratio - 1;
+			bool regression = change < -threshold;
+			if (regression)
+				++regressionNum;
+
+			std::cout << std::left << std::setw(56) << result.name << std::right
+				<< std::setw(16) << std::setprecision(6) << it->second
+				<< std::setw(16) << result.value
+				<< std::setw(9) << std::fixed << std::setprecision(1) << change * 100 << "%" << std::defaultfloat
+				<< (regression ? "  REGRESSION" : "") << std::endl;
+		}
+		return regressionNum;
+	}
+
+	bool parseOptions(int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string arg = argv[i];
+			bool hasValue = i + 1 < argc;
+			if (arg == "--quick")
+				options.quick = true;
+			else if (arg == "--filter" && hasValue)
+				options.filter = argv[++i];
+			else if (arg == "--time" && hasValue)
+				options.time = std::atof(argv[++i]);
+			else if (arg == "--repeat" && hasValue)
+				options.repeat = std::max(1, std::atoi(argv[++i]));
+			else if (arg == "--output" && hasValue)
+				options.output = argv[++i];
+			else if (arg == "--baseline" && hasValue)
+				options.baseline = argv[++i];
+			else if (arg == "--threshold" && hasValue)
+				options.threshold = std::atof(argv[++i]);
+			else
+				return false;
+		}
+		return true;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!parseOptions(argc, argv, options))
+	{
+		std::cerr << "usage: " << argv[0] << " [--quick] [--filter NAME] [--time SEC] [--repeat N] [--output FILE] [--baseline FILE] [--threshold RATIO]" << std::endl;
+		return 2;
+	}
+
+	// \ (quickł͑傫̂Ȃ)
+	std::vector<std::vector<int>> topologies = { { 2, 2, 1 }, { 16, 32, 4 }, { 64, 128, 64, 10 } };
+	std::vector<int> populations = { 20, 200 };
+	std::vector<int> lengths = { 9, 1000 };
+	std::vector<int> threadNums = { 1 };
+	const int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+	if (hardwareThreads > 1)
+		threadNums.push_back(hardwareThreads);
+	if (!options.quick)
+	{
+		topologies.push_back({ 256, 512, 512, 10 });
+		populations.push_back(2000);
+		lengths.push_back(10000);
+	}
+
+	std::cout << "simd = " << simdName(SimdKernel::getLevel()) << ", hardware threads = " << hardwareThreads << std::endl << std::endl;
+
+	Benchmark benchmark(options);
+	benchmarkForward<int>(benchmark, topologies);
+	benchmarkForward<float>(benchmark, topologies);
+	benchmarkForward<double>(benchmark, topologies);
+	benchmarkSparseForward<float>(benchmark, topologies, { 0.9, 0.97 });
+	benchmarkFixedForward<int, FixedNeuralNetwork<int, 2, FixedLayer<2, ActFncID::RELU>, FixedLayer<1, ActFncID::IDENTITY>>>(benchmark, { 2, 2, 1 });
+	benchmarkFixedForward<float, FixedNeuralNetwork<float, 16, FixedLayer<32, ActFncID::RELU>, FixedLayer<4, ActFncID::IDENTITY>>>(benchmark, { 16, 32, 4 });
+	benchmarkBindWeight<float>(benchmark, topologies, populations[1]);
+	benchmarkPopulationForward<int>(benchmark, topologies, populations);
+	benchmarkPopulationForward<double>(benchmark, topologies, populations);
+	benchmarkGeneration<int>(benchmark, populations, lengths, threadNums);
+	benchmarkGeneration<double>(benchmark, populations, lengths, threadNums);
+	benchmarkFitnessCache<int>(benchmark, populations, lengths);
+	benchmarkFitnessCache<double>(benchmark, populations, lengths);
+	benchmarkRacing(benchmark, populations, { 1000, 10000 });
+	benchmarkDataset(benchmark, { 10000, 1000000 });
+	benchmarkFileIO(benchmark, topologies, { populations.front(), populations.back() });
+
+	if (!options.output.empty() && !writeJson(options.output, benchmark))
+	{
+		std::cerr << "failed to write " << options.output << std::endl;
+		return 2;
+	}
+
+	if (!options.baseline.empty())
+	{
+		std::map<std::string, double> baseline;
+		if (!readJson(options.baseline, baseline))
+		{
+			std::cerr << "failed to read " << options.baseline << std::endl;
+			return 2;
+		}
+		if (compare(benchmark, baseline) > 0)
+			return 1;
+	}
+
+	return 0;
+}
@@ -5,6 +5,8 @@
 #include "ReLU.h"
 #include "Sigmoid.h"
 #include "Step.h"
+#include "Tanh.h"
+#include "Softsign.h"
 
 #include <string>
 #include <cassert>
@@ -29,6 +31,12 @@ public:
 		throw;
 	}
 
+	// @return id`Ă銈֐IDȂtrue
+	static constexpr bool in(ActFncID id)
+	{
+		return ActFncID(BEGIN) <= id && id < ActFncID(END);
+	}
+
 	template<typename T>
 	static constexpr ActivationFunction<T>* create(ActFncID id)
 	{
@@ -39,12 +47,160 @@ public:
 		case ActFncID::RELU:
 			return new ReLU<T>;
 		case ActFncID::SIGMOID:
-			if constexpr (std::is_same_v<T, double>)
-				return new Sigmoid;
+			if constexpr (std::is_floating_point_v<T>)
+				return new Sigmoid<T>;
 			else
 				break;
 		case ActFncID::STEP:
 			return new Step<T>;
+		case ActFncID::TANH:
+			if constexpr (std::is_floating_point_v<T>)
+				return new Tanh<T>;
+			else
+				break;
+		case ActFncID::SOFTSIGN:
+			if constexpr (std::is_floating_point_v<T>)
+				return new Softsign<T>;
+			else
+				break;
+		}
+		throw;
+	}
+
+	// @return precision`Ă鐸xȂtrue
+	static constexpr bool in(ActFncPrecision precision)
+	{
+		return ActFncPrecision::EXACT <= precision && precision <= ActFncPrecision::TABLE;
+	}
+
+	/*
+	* z̑SvfɊ֐Kp
+	* 
+	* wƂɈx򂵁Az֐ɌvZ
+	* 
+	* @param id        ֐ID
+	* @param x         z (㏑)
+	* @param n         vf
+	* @param precision vZ̐x (SigmoidTanĥ݉e)
+	*/
+	template<typename T>
+	static void apply(ActFncID id, T* x, int n, ActFncPrecision precision = ActFncPrecision::EXACT)
+	{
+		switch (id)
+		{
+		case ActFncID::IDENTITY:
+			Identity<T>::apply(x, n);
+			return;
+		case ActFncID::RELU:
+			ReLU<T>::apply(x, n);
+			return;
+		case ActFncID::SIGMOID:
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				Sigmoid<T>::apply(x, n, precision);
+				return;
+			}
+			else
+				break;
+		case ActFncID::STEP:
+			Step<T>::apply(x, n);
+			return;
+		case ActFncID::TANH:
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				Tanh<T>::apply(x, n, precision);
+				return;
+			}
+			else
+				break;
+		case ActFncID::SOFTSIGN:
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				Softsign<T>::apply(x, n);
+				return;
+			}
+			else
+				break;
+		}
+		throw;
+	}
+
+	/*
+	* z̑SvfɊ֐Kp (֐RpCɌ߂)
+	* 
+	* FixedNeuralNetwork̂悤Ɋ֐ev[gŌ܂ꍇɎgAȂ
+	* 
+	* @param x         z (㏑)
+	* @param n         vf
+	* @param precision vZ̐x (SigmoidTanĥ݉e)
+	*/
+	template<ActFncID id, typename T>
+	static void apply(T* x, int n, ActFncPrecision precision = ActFncPrecision::EXACT)
+	{
+		static_assert(in(id), "ActFncOperator::apply: undefined ActFncID");
+		static_assert(std::is_floating_point_v<T> || (id != ActFncID::SIGMOID && id != ActFncID::TANH && id != ActFncID::SOFTSIGN), "ActFncOperator::apply: Sigmoid, Tanh and Softsign are only float or double");
+
+		if constexpr (id == ActFncID::IDENTITY)
+			Identity<T>::apply(x, n);
+		else if constexpr (id == ActFncID::RELU)
+			ReLU<T>::apply(x, n);
+		else if constexpr (id == ActFncID::SIGMOID)
+			Sigmoid<T>::apply(x, n, precision);
+		else if constexpr (id == ActFncID::STEP)
+			Step<T>::apply(x, n);
+		else if constexpr (id == ActFncID::TANH)
+			Tanh<T>::apply(x, n, precision);
+		else if constexpr (id == ActFncID::SOFTSIGN)
+			Softsign<T>::apply(x, n);
+	}
+
+	/*
+	* z̑SvfɂĊ֐̔l߂
+	* 
+	* @param id ֐ID
+	* @param x  ֐KpO̒l̔z
+	* @param y  ֐Kp̒l̔z
+	* @param d  l̏ݐ
+	* @param n  vf
+	*/
+	template<typename T>
+	static void derivative(ActFncID id, const T* x, const T* y, T* d, int n)
+	{
+		switch (id)
+		{
+		case ActFncID::IDENTITY:
+			Identity<T>::derivative(x, y, d, n);
+			return;
+		case ActFncID::RELU:
+			ReLU<T>::derivative(x, y, d, n);
+			return;
+		case ActFncID::SIGMOID:
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				Sigmoid<T>::derivative(x, y, d, n);
+				return;
+			}
+			else
+				break;
+		case ActFncID::STEP:
+			Step<T>::derivative(x, y, d, n);
+			return;
+		case ActFncID::TANH:
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				Tanh<T>::derivative(x, y, d, n);
+				return;
+			}
+			else
+				break;
+		case ActFncID::SOFTSIGN:
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				Softsign<T>::derivative(x, y, d, n);
+				return;
+			}
+			else
+				break;
 		}
 		throw;
 	}
@@ -55,14 +211,12 @@ private:
 		"Identity",
 		"ReLU",
 		"Sigmoid",
-		"Step"
+		"Step",
+		"Tanh",
+		"Softsign"
 	};
 	static constexpr int BEGIN = static_cast<int>(ActFncID::IDENTITY);
-	static constexpr int END = static_cast<int>(ActFncID::STEP) + 1;
-	static constexpr bool in(ActFncID id)
-	{
-		return ActFncID(BEGIN) <= id && id < ActFncID(END);
-	}
+	static constexpr int END = static_cast<int>(ActFncID::SOFTSIGN) + 1;
 
 private:
 	ActFncOperator() = delete;
@@ -5,7 +5,17 @@ enum class ActFncID
 	IDENTITY,
 	RELU,
 	SIGMOID,
-	STEP
+	STEP,
+	TANH,
+	SOFTSIGN
+};
+
+// ֐̌vZ̐x (exptanhg֐̂݉e)
+enum class ActFncPrecision
+{
+	EXACT,        // WCuexpEtanhŌvZ
+	APPROXIMATE,  // L֐ŋߎ (float̐xx)
+	TABLE         // \Ɛ`Ԃŋߎ (덷͖6e-6ȉ)
 };
 
 template <typename T>
@@ -0,0 +1,367 @@
+#pragma once
+
+#include "LAFileIO.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <streambuf>
+#include <cstdint>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+/*
+* `FbN|CgʃXbhŏoNX
+*
+* saven̊֐͌Ă񂾎_̏Ԃ̃Xbgɏo (memcpyx̎) Ŗ߂
+* t@Cւ݂͕̏ʃXbhōs
+* t@C "pX.tmp" ɏĂ疼Oς̂ŁAݓrŎ~܂ĂÕ`FbN|Cg͉Ȃ
+* OςOɓefBXN܂ŏo (fsyncEFlushFileBuffers) ̂ŁAdf̌r܂ł̃t@Cɂ͂ȂȂ
+*
+* Xbg̐`FbN|Cg𗭂߂Ȃ̂ŁAg (Xbg * `FbN|Cg̑傫) ܂
+* SẴXbgݑ҂̏ꍇAwait = true Ȃ󂭂܂ő҂Afalse Ȃ炻̃`FbN|CĝĂ
+*
+* t@Č`LAFileIO̊eoutput֐Ɠ
+*/
+class CheckpointWriter
+{
+public:
+	// @param slotNum Xbg̐ Pȏ (P͂PƂ)
+	explicit CheckpointWriter(int slotNum = 2);
+
+	// ݑ҂̃`FbN|CgSďoĂI
+	~CheckpointWriter();
+
+	CheckpointWriter(const CheckpointWriter&) = delete;
+	CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+public:
+	/*
+	* GeneticAlgorithm̃`FbN|Cgݑ҂ɂ
+	*
+	* @param path opX (LAFileIO::outputGeneticAlgorithm֐̌`)
+	* @param ga   oGA
+	* @param wait SẴXbgݑ҂̏ꍇɑ҂Ȃtrue
+	* @return ̂Ăꍇfalse
+	*/
+	template<typename Gene, typename Fitness>
+	bool saveGeneticAlgorithm(const std::string& path, const GeneticAlgorithm<Gene, Fitness>& ga, bool wait = true);
+
+	/*
+	* NeuralNetwork̃`FbN|Cgݑ҂ɂ
+	*
+	* @param path opX (LAFileIO::outputNeuralNetwork֐̌`)
+	* @param nn   oNN
+	* @param wait SẴXbgݑ҂̏ꍇɑ҂Ȃtrue
+	* @return ̂Ăꍇfalse
+	*/
+	template<typename T>
+	bool saveNeuralNetwork(const std::string& path, const NeuralNetwork<T>& nn, bool wait = true);
+
+	/*
+	* NeuralNetwork̃`FbN|Cgft@Č`ŏݑ҂ɂ
+	*
+	* @param path opX (LAFileIO::outputNeuralNetworkModel֐̌`)
+	* @param nn   oNN
+	* @param wait SẴXbgݑ҂̏ꍇɑ҂Ȃtrue
+	* @return ̂Ăꍇfalse
+	*/
+	template<typename T>
+	bool saveNeuralNetworkModel(const std::string& path, const NeuralNetwork<T>& nn, bool wait = true);
+
+	// ݑ҂̃`FbN|CgSďo܂ő҂
+	void flush();
+
+	// @return o`FbN|Cg̐
+	int64_t getWrittenNum() const;
+
+	// @return oɎs`FbN|Cg̐
+	int64_t getFailedNum() const;
+
+	// @return Xbg󂢂Ă炸̂Ă`FbN|Cg̐
+	int64_t getSkippedNum() const;
+
+private:
+	struct Slot
+	{
+		std::string path;
+		std::vector<char> data;
+	};
+
+	// Slot::data̖ɏXg[obt@ (mۍς݂̗eʂg)
+	class SlotBuffer : public std::streambuf
+	{
+	public:
+		explicit SlotBuffer(std::vector<char>& data)
+			: m_data(data)
+		{
+		}
+
+	protected:
+		int_type overflow(int_type c) override
+		{
+			if (c != traits_type::eof())
+				m_data.push_back(static_cast<char>(c));
+			return c;
+		}
+
+		std::streamsize xsputn(const char* s, std::streamsize n) override
+		{
+			m_data.insert(m_data.end(), s, s + n);
+			return n;
+		}
+
+	private:
+		std::vector<char>& m_data;
+	};
+
+	template<typename Function>
+	bool save(const std::string& path, bool wait, Function output);
+
+	void run();
+	bool write(const Slot& slot);
+
+	// datapathɏAfBXN܂ŏoĂ
+	static bool writeDurably(const std::string& path, const std::vector<char>& data);
+
+	// path̃t@CnewPathɒuAO̕ύXfBXN܂ŏo
+	static bool replaceDurably(const std::string& path, const std::string& newPath);
+
+private:
+	std::vector<std::unique_ptr<Slot>> m_slots;
+	std::vector<Slot*> m_free;
+	std::deque<Slot*> m_pending;
+	int m_writing;
+	bool m_running;
+	int64_t m_writtenNum;
+	int64_t m_failedNum;
+	int64_t m_skippedNum;
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::thread m_thread;
+};
+
+
+
+
+inline CheckpointWriter::CheckpointWriter(int slotNum)
+	: m_slots()
+	, m_free()
+	, m_pending()
+	, m_writing()
+	, m_running(true)
+	, m_writtenNum()
+	, m_failedNum()
+	, m_skippedNum()
+	, m_mutex()
+	, m_condition()
+	, m_thread()
+{
+	// XbgPȂƋ󂭂̂iɑ҂̂ŁAŒP͗pӂ
+	slotNum = std::max(slotNum, 1);
+	for (int i = 0; i < slotNum; ++i)
+	{
+		m_slots.push_back(std::make_unique<Slot>());
+		m_free.push_back(m_slots.back().get());
+	}
+	m_thread = std::thread(&CheckpointWriter::run, this);
+}
+
+inline CheckpointWriter::~CheckpointWriter()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_running = false;
+	}
+	m_condition.notify_all();
+	m_thread.join();
+}
+
+template<typename Gene, typename Fitness>
+inline bool CheckpointWriter::saveGeneticAlgorithm(const std::string& path, const GeneticAlgorithm<Gene, Fitness>& ga, bool wait)
+{
+	return save(path, wait, [&ga](std::ostream& os) { return LAFileIO::outputGeneticAlgorithm(os, ga); });
+}
+
+template<typename T>
+inline bool CheckpointWriter::saveNeuralNetwork(const std::string& path, const NeuralNetwork<T>& nn, bool wait)
+{
+	return save(path, wait, [&nn](std::ostream& os) { return LAFileIO::outputNeuralNetwork(os, nn); });
+}
+
+template<typename T>
+inline bool CheckpointWriter::saveNeuralNetworkModel(const std::string& path, const NeuralNetwork<T>& nn, bool wait)
+{
+	return save(path, wait, [&nn](std::ostream& os) { return LAFileIO::outputNeuralNetworkModel(os, nn); });
+}
+
+inline void CheckpointWriter::flush()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_condition.wait(lock, [this]() { return m_pending.empty() && m_writing == 0; });
+}
+
+inline int64_t CheckpointWriter::getWrittenNum() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_writtenNum;
+}
+
+inline int64_t CheckpointWriter::getFailedNum() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_failedNum;
+}
+
+inline int64_t CheckpointWriter::getSkippedNum() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_skippedNum;
+}
+
+template<typename Function>
+inline bool CheckpointWriter::save(const std::string& path, bool wait, Function output)
+{
+	// 󂢂ĂXbg (ȂΑ҂̂Ă)
+	Slot* slot = nullptr;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (m_free.empty() && !wait)
+		{
+			++m_skippedNum;
+			return false;
+		}
+		m_condition.wait(lock, [this]() { return !m_free.empty(); });
+		slot = m_free.back();
+		m_free.pop_back();
+	}
+
+	// ĂяõXbhŌ݂̏ԂXbgɏo
+	slot->path = path;
+	slot->data.clear();
+	SlotBuffer buffer(slot->data);
+	std::ostream os(&buffer);
+	bool serialized = output(os);
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (serialized)
+		{
+			m_pending.push_back(slot);
+		}
+		else
+		{
+			++m_failedNum;
+			m_free.push_back(slot);
+		}
+	}
+	m_condition.notify_all();
+	return serialized;
+}
+
+inline void CheckpointWriter::run()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_condition.wait(lock, [this]() { return !m_pending.empty() || !m_running; });
+		if (m_pending.empty())
+			break;
+
+		Slot* slot = m_pending.front();
+		m_pending.pop_front();
+		++m_writing;
+		lock.unlock();
+
+		bool written = write(*slot);
+
+		lock.lock();
+		--m_writing;
+		++(written ? m_writtenNum : m_failedNum);
+		m_free.push_back(slot);
+		m_condition.notify_all();
+	}
+}
+
+inline bool CheckpointWriter::write(const Slot& slot)
+{
+	const std::string tmp = slot.path + ".tmp";
+	if (!writeDurably(tmp, slot.data))
+		return false;
+
+	// IĂûŁAǂޑ͏ɊSȃt@C
+	return replaceDurably(tmp, slot.path);
+}
+
+inline bool CheckpointWriter::writeDurably(const std::string& path, const std::vector<char>& data)
+{
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	bool written = true;
+	size_t offset = 0;
+	while (written && offset < data.size())
+	{
+		const DWORD size = static_cast<DWORD>(std::min<size_t>(data.size() - offset, 1u << 30));
+		DWORD result = 0;
+		written = WriteFile(file, data.data() + offset, size, &result, nullptr) && result > 0;
+		offset += result;
+	}
+	written = written && FlushFileBuffers(file);
+	return CloseHandle(file) && written;
+#else
+	int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if (fd < 0)
+		return false;
+	bool written = true;
+	size_t offset = 0;
+	while (written && offset < data.size())
+	{
+		const ssize_t result = ::write(fd, data.data() + offset, data.size() - offset);
+		if (result < 0 && errno == EINTR)
+			continue;
+		written = result > 0;
+		offset += written ? static_cast<size_t>(result) : 0;
+	}
+	written = written && ::fsync(fd) == 0;
+	return ::close(fd) == 0 && written;
+#endif
+}
+
+inline bool CheckpointWriter::replaceDurably(const std::string& path, const std::string& newPath)
+{
+#if defined(_WIN32)
+	return MoveFileExA(path.c_str(), newPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+	std::error_code error;
+	std::filesystem::rename(path, newPath, error);
+	if (error)
+		return false;
+
+	// O̕ύX̓fBNg̓eȂ̂ŁAfBNgo
+	std::filesystem::path directory = std::filesystem::path(newPath).parent_path();
+	if (directory.empty())
+		directory = ".";
+	int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+	if (fd < 0)
+		return false;
+	const bool synced = ::fsync(fd) == 0;
+	return ::close(fd) == 0 && synced;
+#endif
+}
@@ -0,0 +1,746 @@
+#pragma once
+
+#include "ModelFile.h"
+#include "MappedFile.h"
+#include "Random.h"
+#include <string>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <new>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+
+/*
+* wKf[^̃t@C̏
+*
+*   DatasetHeader  (64oCg)
+*   0          (͂̐擪64oCgEɑ)
+*              TCY = Tv * ͂̐ (Tv)
+*   0          (o͂̐擪64oCgEɑ)
+*   o           TCY = Tv * o͂̐ (Tv)
+*
+* ͂Əo͂͂ꂼP̘ÄɒûŁAmmapĂ̂܂NN̂܂Ƃ߂ď`d͂ƂĎg
+* ľ^NeuralNetworkTƓ (ModelHeader::WeightType)
+* oCgI[_[͏o̂܂܂ŁAقȂł͓ǂݍ߂Ȃ
+*/
+struct DatasetHeader
+{
+	static constexpr uint32_t MAGIC = 0x5344414c;      // "LADS"
+	static constexpr uint16_t VERSION = 1;
+	static constexpr uint32_t ENDIAN = 0x01020304;
+	static constexpr uint64_t ALIGNMENT = 64;
+
+	uint32_t magic;
+	uint16_t version;
+	uint16_t headerSize;
+	uint32_t endian;
+	uint16_t valueType;
+	uint16_t valueBytes;
+	int32_t inputSize;
+	int32_t targetSize;
+	int64_t sampleNum;
+	uint64_t inputOffset;
+	uint64_t targetOffset;
+	uint64_t fileSize;
+	uint64_t reserved;
+};
+static_assert(sizeof(DatasetHeader) == 64, "DatasetHeader must be 64 bytes");
+
+/*
+* template<typename T>
+* T ľ^ intEfloatEdouble
+*
+* wKf[^̃t@Co
+*
+* ɃTv߂ăt@C̑傫mۂAappend֐ŃTvɏ
+* ɍڂȂ傫̊wKf[^
+*/
+template<typename T>
+class DatasetWriter
+{
+	static_assert(std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double>, "DatasetWriter template is only int, float or double");
+
+public:
+	DatasetWriter();
+	~DatasetWriter();
+
+	DatasetWriter(const DatasetWriter&) = delete;
+	DatasetWriter& operator=(const DatasetWriter&) = delete;
+
+public:
+	/*
+	* t@CAwb_o
+	*
+	* @param path       opX
+	* @param sampleNum  Tv̐ Pȏ
+	* @param inputSize  PTv̓͂̐ Pȏ
+	* @param targetSize PTv̏o͂̐ Pȏ
+	* @return oȂꍇAt@C傫ꍇfalse
+	*/
+	bool open(const std::string& path, int sampleNum, int inputSize, int targetSize);
+
+	/*
+	* Tv
+	*
+	* @param input  ͂̔z TCY = num * ͂̐
+	* @param target o͂̔z TCY = num * o͂̐
+	* @param num    Tv̐
+	* @return oȂꍇAopen֐Ō߂Tv𒴂ꍇfalse
+	*/
+	bool append(const T* input, const T* target, int num = 1);
+
+	/*
+	* t@C
+	*
+	* @return oȂꍇAopen֐Ō߂TvɑȂꍇfalse
+	*/
+	bool close();
+
+	// @return 񂾃Tv̐
+	int getWrittenNum() const;
+
+private:
+	std::ofstream m_ofs;
+	DatasetHeader m_header;
+	int m_writtenNum;
+};
+
+/*
+* ~job`
+*
+* inputtarget64oCgEɑĂ
+* Dataset::nextBatch֐ɌĂԂ܂Ŏg
+*/
+template<typename T>
+struct DatasetBatch
+{
+	const T* input = nullptr;   //  TCY = sampleNum * ͂̐
+	const T* target = nullptr;  // o TCY = sampleNum * o͂̐
+	const int* index = nullptr; // eTṽt@C̃CfbNX TCY = sampleNum
+	int sampleNum = 0;
+};
+
+/*
+* template<typename T>
+* T ľ^ intEfloatEdouble
+*
+* wKf[^̃t@C (DatasetWriterŏo) }bvA~job`ɓn
+*
+* בւ̓CfbNX̔z񂾂ōsAt@C̃f[^͓Ȃ
+* ̃~job`͕ʃXbhŃt@CW߂Ă̂ŁAwKƃt@C̓ǂݍ (y[WC) dȂ
+* f[^̓y[WLbVKvɂȂɓǂ܂̂ŁAɍڂȂ傫łg
+*
+* g
+*     Dataset<float> dataset;
+*     dataset.open(path);
+*     dataset.setBatch(64, true);
+*     for (int epoch = 0; epoch < epochNum; ++epoch)
+*     {
+*         dataset.beginEpoch();
+*         DatasetBatch<float> batch;
+*         while (dataset.nextBatch(batch))
+*             nn.backpropagation(batch.input, batch.target, batch.sampleNum);
+*     }
+*
+* ̃Xbh瓯ɌĂяoȂ
+*/
+template<typename T>
+class Dataset
+{
+	static_assert(std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double>, "Dataset template is only int, float or double");
+
+public:
+	Dataset();
+	~Dataset();
+
+	Dataset(const Dataset&) = delete;
+	Dataset& operator=(const Dataset&) = delete;
+
+public:
+	/*
+	* wKf[^̃t@C}bv
+	*
+	* @param path DatasetWriterŏot@C
+	* @return }bvłȂꍇsȃt@C (ľ^TƈقȂꍇ܂) ̏ꍇfalse
+	*/
+	bool open(const std::string& path);
+
+	void close();
+
+	/*
+	* ~job`̐ݒ (beginEpoch֐g)
+	*
+	* ʃXbh~job`W߂ĂԂɌĂł悢 (WߏI܂Ō݂̃G|bN̐ݒ͕ςȂ)
+	*
+	* @param batchSize P~job`̃Tv̐ Pȏ
+	* @param shuffle   G|bNƂɃTv̏Ԃבւꍇtrue
+	* @param dropLast  TvbatchSizeŊ؂ȂƂAŌ̏~job`̂Ăꍇtrue
+	*/
+	void setBatch(int batchSize, bool shuffle, bool dropLast = false);
+
+	/*
+	* בւ̗̃V[h̐ݒ
+	*
+	* ݒ肵Ȃꍇstd::random_device瓾V[hg
+	*
+	* @param seed V[h
+	*/
+	void setSeed(uint64_t seed);
+
+	/*
+	* VG|bNn߂
+	*
+	* ÕG|bN̎c̃~job`͎̂Ă
+	*/
+	void beginEpoch();
+
+	/*
+	* ̃~job`𓾂
+	*
+	* Oɓ~job`͂̊֐ĂԂƎgȂȂ
+	*
+	* @param batch ~job`̏ݐ
+	* @return G|bN̏IɒBꍇfalse
+	*/
+	bool nextBatch(DatasetBatch<T>& batch);
+
+	// @return t@C}bvĂꍇtrue
+	bool isOpen() const;
+
+	// @return Tv̐
+	int getSampleNum() const;
+
+	// @return PTv̓͂̐
+	int getInputSize() const;
+
+	// @return PTv̏o͂̐
+	int getTargetSize() const;
+
+	// @return PG|bÑ~job`̐
+	int getBatchNum() const;
+
+	// @return beginEpoch֐Ă񂾉
+	int getEpoch() const;
+
+	// @return STv̓ (t@Cw) TCY = Tv * ͂̐
+	const T* getInputs() const;
+
+	// @return STv̏o (t@Cw) TCY = Tv * o͂̐
+	const T* getTargets() const;
+
+	// @return indexԖ(0-based)̃Tv̓ (t@Cw)
+	const T* getInput(int index) const;
+
+	// @return indexԖ(0-based)̃Tv̏o (t@Cw)
+	const T* getTarget(int index) const;
+
+private:
+	struct AlignedDelete
+	{
+		void operator()(T* p) const
+		{
+			::operator delete[](p, std::align_val_t(DatasetHeader::ALIGNMENT));
+		}
+	};
+	using AlignedArray = std::unique_ptr<T[], AlignedDelete>;
+
+	// ~job`W߂ (Q݂Ɏg)
+	struct Slot
+	{
+		AlignedArray input;
+		AlignedArray target;
+		int batch = -1;    // W߂~job`̔ԍ (-1͋)
+		int capacity = 0;  // mۂTv̐
+	};
+	static constexpr int SLOT_NUM = 2;
+
+	static AlignedArray allocate(size_t size);
+
+	// batchԖڂ̃~job`slotɏW߂
+	void gather(int batch, Slot& slot) const;
+
+	// ʃXbhŎ̃~job`Wߑ
+	void run();
+
+	// ʃXbh~߁AW߂~job`̂Ă
+	void stop();
+
+private:
+	MappedFile m_file;
+	const T* m_input;
+	const T* m_target;
+	int m_sampleNum;
+	int m_inputSize;
+	int m_targetSize;
+	int m_batchSize;           // ݂̃G|bN̐ݒ (ʃXbhǂނ̂ŁAbeginEpoch֐Ŏ~߂Ă珑)
+	bool m_shuffle;
+	bool m_dropLast;
+	int m_pendingBatchSize;    // setBatch֐̐ݒ (beginEpoch֐Ŕf)
+	bool m_pendingShuffle;
+	bool m_pendingDropLast;
+	Random m_random;
+	int m_epoch;
+	std::vector<int> m_index;  // G|bÑTv̏
+	int m_batchNum;            // ݂̃G|bÑ~job`̐
+	int m_fillBatch;           // ʃXbhɏW߂~job`̔ԍ
+	int m_readBatch;           // nextBatch֐ɓn~job`̔ԍ
+	int m_heldSlot;            // nextBatch֐œnXbg (-1͂Ȃ)
+	bool m_filling;
+	bool m_running;
+	Slot m_slots[SLOT_NUM];
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::thread m_thread;
+};
+
+
+
+
+template<typename T>
+inline DatasetWriter<T>::DatasetWriter()
+	: m_ofs()
+	, m_header()
+	, m_writtenNum()
+{
+}
+
+template<typename T>
+inline DatasetWriter<T>::~DatasetWriter()
+{
+	if (m_ofs.is_open())
+		close();
+}
+
+template<typename T>
+inline bool DatasetWriter<T>::open(const std::string& path, int sampleNum, int inputSize, int targetSize)
+{
+	if (m_ofs.is_open())
+		m_ofs.close();
+	m_writtenNum = 0;
+	if (sampleNum < 1 || inputSize < 1 || targetSize < 1)
+		return false;
+
+	// t@C̑傫Xg[̈ʒu (t64bit) Ɏ܂Ȃꍇ͊|Z̑Oɒe
+	if (static_cast<uint64_t>(inputSize) + static_cast<uint64_t>(targetSize) > (INT64_MAX / 2) / sizeof(T) / static_cast<uint64_t>(sampleNum))
+		return false;
+
+	const uint64_t inputOffset = ModelFile::align(sizeof(DatasetHeader));
+	const uint64_t targetOffset = ModelFile::align(inputOffset + sizeof(T) * static_cast<uint64_t>(sampleNum) * static_cast<uint64_t>(inputSize));
+	const uint64_t fileSize = targetOffset + sizeof(T) * static_cast<uint64_t>(sampleNum) * static_cast<uint64_t>(targetSize);
+
+	m_header = DatasetHeader();
+	m_header.magic = DatasetHeader::MAGIC;
+	m_header.version = DatasetHeader::VERSION;
+	m_header.headerSize = sizeof(DatasetHeader);
+	m_header.endian = DatasetHeader::ENDIAN;
+	m_header.valueType = ModelFile::weightType<T>();
+	m_header.valueBytes = sizeof(T);
+	m_header.inputSize = inputSize;
+	m_header.targetSize = targetSize;
+	m_header.sampleNum = sampleNum;
+	m_header.inputOffset = inputOffset;
+	m_header.targetOffset = targetOffset;
+	m_header.fileSize = fileSize;
+
+	m_ofs.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!m_ofs)
+		return false;
+
+	// 0߂܂߂t@CŜ̑傫Ɋmۂ
+	char zero[DatasetHeader::ALIGNMENT] = {};
+	m_ofs.write(reinterpret_cast<const char*>(&m_header), sizeof(DatasetHeader));
+	m_ofs.write(zero, inputOffset - sizeof(DatasetHeader));
+	m_ofs.seekp(fileSize - 1);
+	m_ofs.write(zero, 1);
+	if (!m_ofs)
+	{
+		m_ofs.close();
+		return false;
+	}
+	return true;
+}
+
+template<typename T>
+inline bool DatasetWriter<T>::append(const T* input, const T* target, int num)
+{
+	if (!m_ofs.is_open() || num < 0 || num > m_header.sampleNum - m_writtenNum)
+		return false;
+
+	const uint64_t inputBytes = sizeof(T) * m_header.inputSize;
+	const uint64_t targetBytes = sizeof(T) * m_header.targetSize;
+	m_ofs.seekp(m_header.inputOffset + inputBytes * m_writtenNum);
+	m_ofs.write(reinterpret_cast<const char*>(input), inputBytes * num);
+	m_ofs.seekp(m_header.targetOffset + targetBytes * m_writtenNum);
+	m_ofs.write(reinterpret_cast<const char*>(target), targetBytes * num);
+	if (!m_ofs)
+		return false;
+
+	m_writtenNum += num;
+	return true;
+}
+
+template<typename T>
+inline bool DatasetWriter<T>::close()
+{
+	if (!m_ofs.is_open())
+		return false;
+	bool written = static_cast<bool>(m_ofs.flush());
+	m_ofs.close();
+	return written && m_writtenNum == m_header.sampleNum;
+}
+
+template<typename T>
+inline int DatasetWriter<T>::getWrittenNum() const
+{
+	return m_writtenNum;
+}
+
+template<typename T>
+inline Dataset<T>::Dataset()
+	: m_file()
+	, m_input()
+	, m_target()
+	, m_sampleNum()
+	, m_inputSize()
+	, m_targetSize()
+	, m_batchSize(1)
+	, m_shuffle()
+	, m_dropLast()
+	, m_pendingBatchSize(1)
+	, m_pendingShuffle()
+	, m_pendingDropLast()
+	, m_random()
+	, m_epoch()
+	, m_index()
+	, m_batchNum()
+	, m_fillBatch()
+	, m_readBatch()
+	, m_heldSlot(-1)
+	, m_filling()
+	, m_running()
+	, m_slots()
+	, m_mutex()
+	, m_condition()
+	, m_thread()
+{
+}
+
+template<typename T>
+inline Dataset<T>::~Dataset()
+{
+	close();
+}
+
+template<typename T>
+inline bool Dataset<T>::open(const std::string& path)
+{
+	close();
+	if (!m_file.open(path) || m_file.getSize() < sizeof(DatasetHeader))
+	{
+		close();
+		return false;
+	}
+
+	DatasetHeader header;
+	memcpy(&header, m_file.getData(), sizeof(DatasetHeader));
+	if (header.magic != DatasetHeader::MAGIC || header.version != DatasetHeader::VERSION || header.headerSize != sizeof(DatasetHeader)
+		|| header.endian != DatasetHeader::ENDIAN || header.valueType != ModelFile::weightType<T>() || header.valueBytes != sizeof(T)
+		|| header.sampleNum < 1 || header.sampleNum > INT_MAX || header.inputSize < 1 || header.targetSize < 1
+		|| header.fileSize > m_file.getSize())
+	{
+		close();
+		return false;
+	}
+
+	// |ZEZȂ悤ɁAPTv̒l̐t@C̑傫ŗ}Ă傫߂
+	const uint64_t valueNumLimit = header.fileSize / sizeof(T) / static_cast<uint64_t>(header.sampleNum);
+	if (static_cast<uint64_t>(header.inputSize) > valueNumLimit || static_cast<uint64_t>(header.targetSize) > valueNumLimit)
+	{
+		close();
+		return false;
+	}
+	const uint64_t inputBytes = sizeof(T) * static_cast<uint64_t>(header.sampleNum) * static_cast<uint64_t>(header.inputSize);
+	const uint64_t targetBytes = sizeof(T) * static_cast<uint64_t>(header.sampleNum) * static_cast<uint64_t>(header.targetSize);
+	if (header.inputOffset % DatasetHeader::ALIGNMENT != 0 || header.targetOffset % DatasetHeader::ALIGNMENT != 0
+		|| header.inputOffset < sizeof(DatasetHeader) || header.targetOffset < header.inputOffset || header.targetOffset > header.fileSize
+		|| header.targetOffset - header.inputOffset < inputBytes || header.fileSize - header.targetOffset < targetBytes)
+	{
+		close();
+		return false;
+	}
+
+	m_input = reinterpret_cast<const T*>(m_file.getData() + header.inputOffset);
+	m_target = reinterpret_cast<const T*>(m_file.getData() + header.targetOffset);
+	m_sampleNum = static_cast<int>(header.sampleNum);
+	m_inputSize = header.inputSize;
+	m_targetSize = header.targetSize;
+	m_index.resize(m_sampleNum);
+	for (int i = 0; i < m_sampleNum; ++i)
+		m_index[i] = i;
+
+	m_running = true;
+	m_thread = std::thread(&Dataset::run, this);
+	return true;
+}
+
+template<typename T>
+inline void Dataset<T>::close()
+{
+	if (m_thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_running = false;
+		}
+		m_condition.notify_all();
+		m_thread.join();
+	}
+
+	m_file.close();
+	m_input = nullptr;
+	m_target = nullptr;
+	m_sampleNum = 0;
+	m_inputSize = 0;
+	m_targetSize = 0;
+	m_epoch = 0;
+	m_index.clear();
+	m_batchNum = 0;
+	m_fillBatch = 0;
+	m_readBatch = 0;
+	m_heldSlot = -1;
+	for (Slot& slot : m_slots)
+		slot = Slot();
+}
+
+template<typename T>
+inline void Dataset<T>::setBatch(int batchSize, bool shuffle, bool dropLast)
+{
+	m_pendingBatchSize = std::max(batchSize, 1);
+	m_pendingShuffle = shuffle;
+	m_pendingDropLast = dropLast;
+}
+
+template<typename T>
+inline void Dataset<T>::setSeed(uint64_t seed)
+{
+	m_random.seed(seed);
+}
+
+template<typename T>
+inline void Dataset<T>::beginEpoch()
+{
+	if (!isOpen())
+		return;
+
+	// ʃXbhÕG|bN̏ԂݒǂłԂ͏Ȃ
+	stop();
+
+	// בւ߂ꍇ́AATvƂĂ܂Ƃ߂ăRs[ł悤ɏԂ߂
+	if (m_shuffle && !m_pendingShuffle)
+	{
+		for (int i = 0; i < m_sampleNum; ++i)
+			m_index[i] = i;
+	}
+	m_batchSize = m_pendingBatchSize;
+	m_shuffle = m_pendingShuffle;
+	m_dropLast = m_pendingDropLast;
+
+	if (m_shuffle)
+	{
+		for (int i = m_sampleNum - 1; i > 0; --i)
+			std::swap(m_index[i], m_index[m_random(0, i)]);
+	}
+
+	const int batchNum = m_dropLast ? m_sampleNum / m_batchSize : (m_sampleNum + m_batchSize - 1) / m_batchSize;
+	for (Slot& slot : m_slots)
+	{
+		// ÕG|bNƓ傫Ȃg
+		if (slot.capacity != m_batchSize)
+		{
+			slot.input = allocate(static_cast<size_t>(m_batchSize) * m_inputSize);
+			slot.target = allocate(static_cast<size_t>(m_batchSize) * m_targetSize);
+			slot.capacity = m_batchSize;
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_batchNum = batchNum;
+		m_fillBatch = 0;
+		m_readBatch = 0;
+		++m_epoch;
+	}
+	m_condition.notify_all();
+}
+
+template<typename T>
+inline bool Dataset<T>::nextBatch(DatasetBatch<T>& batch)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	// OɓnXbg󂯂
+	if (m_heldSlot >= 0)
+	{
+		m_slots[m_heldSlot].batch = -1;
+		m_heldSlot = -1;
+		m_condition.notify_all();
+	}
+	if (m_readBatch >= m_batchNum)
+		return false;
+
+	const int slotIndex = m_readBatch % SLOT_NUM;
+	Slot& slot = m_slots[slotIndex];
+	m_condition.wait(lock, [&]() { return slot.batch == m_readBatch; });
+
+	const int begin = m_readBatch * m_batchSize;
+	batch.input = slot.input.get();
+	batch.target = slot.target.get();
+	batch.index = &m_index[begin];
+	batch.sampleNum = std::min(m_batchSize, m_sampleNum - begin);
+	m_heldSlot = slotIndex;
+	++m_readBatch;
+	return true;
+}
+
+template<typename T>
+inline bool Dataset<T>::isOpen() const
+{
+	return m_file.getData() != nullptr;
+}
+
+template<typename T>
+inline int Dataset<T>::getSampleNum() const
+{
+	return m_sampleNum;
+}
+
+template<typename T>
+inline int Dataset<T>::getInputSize() const
+{
+	return m_inputSize;
+}
+
+template<typename T>
+inline int Dataset<T>::getTargetSize() const
+{
+	return m_targetSize;
+}
+
+template<typename T>
+inline int Dataset<T>::getBatchNum() const
+{
+	return m_batchNum;
+}
+
+template<typename T>
+inline int Dataset<T>::getEpoch() const
+{
+	return m_epoch;
+}
+
+template<typename T>
+inline const T* Dataset<T>::getInputs() const
+{
+	return m_input;
+}
+
+template<typename T>
+inline const T* Dataset<T>::getTargets() const
+{
+	return m_target;
+}
+
+template<typename T>
+inline const T* Dataset<T>::getInput(int index) const
+{
+	return m_input + static_cast<size_t>(index) * m_inputSize;
+}
+
+template<typename T>
+inline const T* Dataset<T>::getTarget(int index) const
+{
+	return m_target + static_cast<size_t>(index) * m_targetSize;
+}
+
+template<typename T>
+inline typename Dataset<T>::AlignedArray Dataset<T>::allocate(size_t size)
+{
+	// 64oCgEɑA64oCgPʂɂSIMDœǂ݉zĂ͈͓ɂ
+	const size_t bytes = ModelFile::align(sizeof(T) * size);
+	return AlignedArray(static_cast<T*>(::operator new[](bytes, std::align_val_t(DatasetHeader::ALIGNMENT))));
+}
+
+template<typename T>
+inline void Dataset<T>::gather(int batch, Slot& slot) const
+{
+	const int begin = batch * m_batchSize;
+	const int num = std::min(m_batchSize, m_sampleNum - begin);
+	const int* index = &m_index[begin];
+	T* input = slot.input.get();
+	T* target = slot.target.get();
+
+	if (!m_shuffle)
+	{
+		// ATv͂܂Ƃ߂ăRs[
+		memcpy(input, getInput(begin), sizeof(T) * num * m_inputSize);
+		memcpy(target, getTarget(begin), sizeof(T) * num * m_targetSize);
+		return;
+	}
+	for (int i = 0; i < num; ++i)
+	{
+		memcpy(input + static_cast<size_t>(i) * m_inputSize, getInput(index[i]), sizeof(T) * m_inputSize);
+		memcpy(target + static_cast<size_t>(i) * m_targetSize, getTarget(index[i]), sizeof(T) * m_targetSize);
+	}
+}
+
+template<typename T>
+inline void Dataset<T>::run()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		// W߂Ԃ̃Xbg󂭂܂ő҂
+		m_condition.wait(lock, [this]()
+			{
+				if (!m_running)
+					return true;
+				if (m_fillBatch >= m_batchNum)
+					return false;
+				const int slotIndex = m_fillBatch % SLOT_NUM;
+				return m_slots[slotIndex].batch < 0 && m_heldSlot != slotIndex;
+			});
+		if (!m_running)
+			break;
+
+		const int batch = m_fillBatch++;
+		Slot& slot = m_slots[batch % SLOT_NUM];
+		m_filling = true;
+		lock.unlock();
+
+		gather(batch, slot);
+
+		lock.lock();
+		m_filling = false;
+		slot.batch = batch;
+		m_condition.notify_all();
+	}
+}
+
+template<typename T>
+inline void Dataset<T>::stop()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_batchNum = 0;
+	m_fillBatch = 0;
+	m_readBatch = 0;
+	m_condition.wait(lock, [this]() { return !m_filling; });
+	for (Slot& slot : m_slots)
+		slot.batch = -1;
+	m_heldSlot = -1;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+/*
+* ֐̋ߎvZ
+*
+* ǂ̊֐Ȃ̂ŁAzɓKp郋[v̓RpCxNg₷
+*/
+class FastMath
+{
+public:
+	/*
+	* tanh̗L֐ߎ (q13E6)
+	*
+	* 덷float̊ۂߌ덷x (1e-7ȉ) ŁAdoublełfloatƓx̐xɂȂ
+	*
+	* @param x l
+	* @return tanh(x)̋ߎl
+	*/
+	template<typename T>
+	static T tanhApproximate(T x)
+	{
+		static_assert(std::is_floating_point_v<T>, "FastMath::tanhApproximate template is only float or double");
+
+		// ͈̔͂̊Oł͋ߎl}1𒴂̂Ő؂l߂
+		// (GCCł-fno-trapping-matĥƂrƑI̖߂ɂȂA[vxNg)
+		// NaN͔rfalseɂȂ̂ł̂܂ܒʂAʂNaNɂȂ
+		constexpr T CLAMP = T(7.90531110763549805);
+		x = x > CLAMP ? CLAMP : x;
+		x = x < -CLAMP ? -CLAMP : x;
+
+		const T x2 = x * x;
+		T p = x2 * T(-2.76076847742355e-16) + T(2.00018790482477e-13);
+		p = x2 * p + T(-8.60467152213735e-11);
+		p = x2 * p + T(5.12229709037114e-08);
+		p = x2 * p + T(1.48572235717979e-05);
+		p = x2 * p + T(6.37261928875436e-04);
+		p = x2 * p + T(4.89352455891786e-03);
+		p = x * p;
+
+		T q = x2 * T(1.19825839466702e-06) + T(1.18534705686654e-04);
+		q = x2 * q + T(2.26843463243900e-03);
+		q = x2 * q + T(4.89352518554385e-03);
+		return p / q;
+	}
+
+	/*
+	* tanh̕\ (`)
+	*
+	* [-TABLE_RANGE, TABLE_RANGE]  TABLE_SIZE Ԃɕ\gA덷͖6e-6ȉ
+	* ͈͂̊Ó}1 (tanh(TABLE_RANGE)Ƃ͖̍2e-7)ANaNNaNԂ
+	*
+	* @param x     l
+	* @param table getTanhTable֐œ\ ([v̊OœĂ)
+	* @return tanh(x)̋ߎl
+	*/
+	template<typename T>
+	static T tanhTable(T x, const T* table)
+	{
+		static_assert(std::is_floating_point_v<T>, "FastMath::tanhTable template is only float or double");
+
+		// NaN͔rfalseɂȂ̂-TABLE_RANGEɐ؂l߁A\͈̔͂̊Oǂ܂Ȃ悤ɂ
+		constexpr T SCALE = T(TABLE_SIZE) / (2 * TABLE_RANGE);
+		T clamped = x > -T(TABLE_RANGE) ? x : -T(TABLE_RANGE);
+		clamped = clamped < T(TABLE_RANGE) ? clamped : T(TABLE_RANGE);
+
+		T position = (clamped + T(TABLE_RANGE)) * SCALE;
+		int index = static_cast<int>(position);
+		index = index < TABLE_SIZE - 1 ? index : TABLE_SIZE - 1;
+		T fraction = position - index;
+		T value = table[index] + (table[index + 1] - table[index]) * fraction;
+
+		// NaN͎gƓȂ̂ŁA̒l (NaN) Ԃ
+		return x == x ? value : x;
+	}
+
+	// @return tanhTable֐Ŏg\ TCY = TABLE_SIZE + 1
+	template<typename T>
+	static const T* getTanhTable()
+	{
+		static const Table<T> table;
+		return table.value;
+	}
+
+public:
+	// \͈̔͂ƋԂ̐
+	static constexpr int TABLE_RANGE = 8;
+	static constexpr int TABLE_SIZE = 2048;
+
+private:
+	template<typename T>
+	struct Table
+	{
+		T value[TABLE_SIZE + 1];
+
+		Table()
+		{
+			for (int i = 0; i <= TABLE_SIZE; ++i)
+				value[i] = static_cast<T>(std::tanh(-TABLE_RANGE + 2.0 * TABLE_RANGE * i / TABLE_SIZE));
+		}
+	};
+
+private:
+	FastMath() = delete;
+};
@@ -0,0 +1,410 @@
+#pragma once
+
+#include "GeneticAlgorithm.h"
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <cstring>
+#include <cstdint>
+
+/*
+* FitnessCache̓v
+*
+* reset֐EclearStatistics֐Ăł̗݌v
+*/
+struct FitnessCacheStatistics
+{
+	int64_t lookupNum = 0;     // KxT̂̐
+	int64_t hitNum = 0;        // LbVɂ̂̐
+	int64_t duplicateNum = 0;  // LbVɂȂAɓF̂̌̂ (]͂Pōς)
+	int64_t insertNum = 0;     // LbVɒǉ
+	int64_t evictionNum = 0;   // eʂ𒴂ߒǂo
+	int size = 0;              // LbVɂ鐔
+	int capacity = 0;          // LbV̗e
+
+	// @return ]Ȃ̂̊ 0`1
+	double getHitRate() const
+	{
+		return lookupNum > 0 ? static_cast<double>(hitNum + duplicateNum) / lookupNum : 0.0;
+	}
+};
+
+/*
+* template<typename Gene, typename Fitness>
+* Gene    F̂̌^ intEfloatEdouble
+* Fitness Kx̌^ intEfloatEdouble
+*
+* F̂̓eKxLbV
+*
+* ɎzꂽG[g̂AF̂̎q (͈͂̐̈`qő) ̕]Ȃ
+* Kx͐F̂Ō܂ (F̂ȂɓKxɂȂ) ꍇ̂ݎg
+*
+* F̂128bit̃nbVlŋʂAF͕̂̂̂ێȂ (Փ˂̊m͖łقǏ)
+* eʂ𒴂ƃNbN@ (ŋ߈ĂȂ̂) Œǂo
+*
+* ̃NX̐͂܂reset֐s邱
+* (sO͉oAS̂]KvȌ̂Ƃ)
+*
+* g
+*     FitnessCache<int, int> cache;
+*     cache.reset(10000);
+*     while (...)
+*     {
+*         // LbVɂȂ̂functionŕ]Aga.evaluate֐܂ŌĂ
+*         cache.evaluate(ga, [&](int index, const int* chromosome) { return simulate(chromosome); });
+*         ga.generateNextGeneration();
+*     }
+*
+*     ]ŕɍsꍇ́Alookup֐ŕ]̕KvȌ̂𓾂āA]store֐Ă
+*
+* ̃Xbh瓯ɌĂяoȂ
+*/
+template<typename Gene, typename Fitness>
+class FitnessCache
+{
+	static_assert(std::is_same_v<Gene, int> || std::is_same_v<Gene, float> || std::is_same_v<Gene, double>, "FitnessCache template is only int, float or double");
+	static_assert(std::is_same_v<Fitness, int> || std::is_same_v<Fitness, float> || std::is_same_v<Fitness, double>, "FitnessCache template is only int, float or double");
+
+public:
+	FitnessCache();
+	~FitnessCache();
+
+	FitnessCache(const FitnessCache&) = delete;
+	FitnessCache& operator=(const FitnessCache&) = delete;
+
+	FitnessCache(FitnessCache&&) = default;
+	FitnessCache& operator=(FitnessCache&&) = default;
+
+public:
+	/*
+	* eʂݒ肵ALbVƓvɂ
+	*
+	* @param capacity oĂKx̐ Pȏ (ڈ͐l̐{`\{)
+	*/
+	void reset(int capacity);
+
+	// v0ɖ߂
+	void clearStatistics();
+
+	/*
+	* F̂̓KxT
+	*
+	* @param chromosome F̂̔z TCY = length
+	* @param length     F̂̒
+	* @param fitness    ꍇ̓Kx̏ݐ
+	* @return ꍇtrue
+	*/
+	bool find(const Gene* chromosome, int length, Fitness& fitness);
+
+	/*
+	* F̂̓Kxǉ (ɂꍇ͏㏑)
+	*
+	* @param chromosome F̂̔z TCY = length
+	* @param length     F̂̒
+	* @param fitness    Kx
+	*/
+	void insert(const Gene* chromosome, int length, Fitness fitness);
+
+	/*
+	* gȃS̂̓KxLbV疄߁A]KvȌ̂𓾂
+	*
+	* ɓF̂̌̂ꍇ́Aŏ̂P̂]KvȌ̂Ƃ
+	*
+	* @param ga        ]OGeneticAlgorithm
+	* @param fitnesses Kx̔z TCY = l (LbVɂ̂̕܂)
+	* @param unknown   ]KvȌ̂̃CfbNX̏ݐ (O̓e͏)
+	* @return ]KvȌ̂̐
+	*/
+	int lookup(const GeneticAlgorithm<Gene, Fitness>& ga, Fitness* fitnesses, std::vector<int>& unknown);
+
+	/*
+	* lookup֐œ̂]ɌĂсAKxLbVɒǉ
+	*
+	* ̓F̂̌̂̓Kxfitnessesɏ
+	*
+	* @param ga        lookup֐ɓnGeneticAlgorithm (̌ɕύXȂ)
+	* @param fitnesses Kx̔z TCY = l (unknowň͕̂]ς݂ł邱)
+	* @param unknown   lookup֐œCfbNX
+	*/
+	void store(const GeneticAlgorithm<Gene, Fitness>& ga, Fitness* fitnesses, const std::vector<int>& unknown);
+
+	/*
+	* LbVɂȂ̂]AS̂̓Kxga.evaluate֐Ă
+	*
+	* @param ga       ]GeneticAlgorithm
+	* @param function Kx߂֐ Fitness function(int index, const Gene* chromosome)
+	*/
+	template<typename Function>
+	void evaluate(GeneticAlgorithm<Gene, Fitness>& ga, Function function);
+
+	// @return v
+	FitnessCacheStatistics getStatistics() const;
+
+	/*
+	* F̂128bit̃nbVl
+	*
+	* @param chromosome F̂̔z TCY = length
+	* @param length     F̂̒
+	* @param hash       nbVl̏ݐ
+	*/
+	static void computeHash(const Gene* chromosome, int length, uint64_t hash[2]);
+
+private:
+	struct Entry
+	{
+		uint64_t hash[2] = {};
+		Fitness fitness = 0;
+		bool referenced = false; // ONbN̐jʉ߂Ăꂽꍇtrue
+	};
+
+	// nbVlŒT
+	bool find(const uint64_t hash[2], Fitness& fitness);
+
+	// nbVlŒǉ
+	void insert(const uint64_t hash[2], Fitness fitness);
+
+	// 󂢂Ă (܂͒ǂo) ꏊ𓾂
+	int getFreeSlot();
+
+private:
+	std::unique_ptr<Entry[]> m_entries;
+	std::unordered_map<uint64_t, int> m_index; // nbVl̑Oꏊ
+	int m_capacity;
+	int m_size;
+	int m_hand;
+	FitnessCacheStatistics m_statistics;
+	std::vector<std::pair<int, int>> m_duplicates; // lookup֐Ō (F̂̌, ])
+	std::vector<uint64_t> m_unknownHash;           // lookup֐œ]KvȌ̂̃nbVl TCY = ]KvȌ̂̐ * 2
+	std::vector<int> m_unknown;
+	std::unique_ptr<Fitness[]> m_fitnesses;
+	int m_fitnessesSize;
+};
+
+
+
+
+template<typename Gene, typename Fitness>
+inline FitnessCache<Gene, Fitness>::FitnessCache()
+	: m_entries()
+	, m_index()
+	, m_capacity()
+	, m_size()
+	, m_hand()
+	, m_statistics()
+	, m_duplicates()
+	, m_unknownHash()
+	, m_unknown()
+	, m_fitnesses()
+	, m_fitnessesSize()
+{
+}
+
+template<typename Gene, typename Fitness>
+inline FitnessCache<Gene, Fitness>::~FitnessCache()
+{
+}
+
+template<typename Gene, typename Fitness>
+inline void FitnessCache<Gene, Fitness>::reset(int capacity)
+{
+	m_capacity = std::max(capacity, 1);
+	m_entries.reset(new Entry[m_capacity]);
+	m_index.clear();
+	m_index.reserve(m_capacity);
+	m_size = 0;
+	m_hand = 0;
+	m_statistics = FitnessCacheStatistics();
+}
+
+template<typename Gene, typename Fitness>
+inline void FitnessCache<Gene, Fitness>::clearStatistics()
+{
+	m_statistics = FitnessCacheStatistics();
+}
+
+template<typename Gene, typename Fitness>
+inline bool FitnessCache<Gene, Fitness>::find(const Gene* chromosome, int length, Fitness& fitness)
+{
+	uint64_t hash[2];
+	computeHash(chromosome, length, hash);
+	return find(hash, fitness);
+}
+
+template<typename Gene, typename Fitness>
+inline void FitnessCache<Gene, Fitness>::insert(const Gene* chromosome, int length, Fitness fitness)
+{
+	uint64_t hash[2];
+	computeHash(chromosome, length, hash);
+	insert(hash, fitness);
+}
+
+template<typename Gene, typename Fitness>
+inline bool FitnessCache<Gene, Fitness>::find(const uint64_t hash[2], Fitness& fitness)
+{
+	++m_statistics.lookupNum;
+
+	auto it = m_index.find(hash[0]);
+	if (it == m_index.end())
+		return false;
+	Entry& entry = m_entries[it->second];
+	if (entry.hash[1] != hash[1])
+		return false;
+
+	entry.referenced = true;
+	fitness = entry.fitness;
+	++m_statistics.hitNum;
+	return true;
+}
+
+template<typename Gene, typename Fitness>
+inline void FitnessCache<Gene, Fitness>::insert(const uint64_t hash[2], Fitness fitness)
+{
+	// reset֐sO͊oꏊȂ
+	if (m_capacity == 0)
+		return;
+
+	// Ô (㔼قȂĂ) ㏑
+	auto it = m_index.find(hash[0]);
+	int slot = it != m_index.end() ? it->second : getFreeSlot();
+
+	Entry& entry = m_entries[slot];
+	entry.hash[0] = hash[0];
+	entry.hash[1] = hash[1];
+	entry.fitness = fitness;
+	entry.referenced = false;
+	m_index[hash[0]] = slot;
+	++m_statistics.insertNum;
+}
+
+template<typename Gene, typename Fitness>
+inline int FitnessCache<Gene, Fitness>::lookup(const GeneticAlgorithm<Gene, Fitness>& ga, Fitness* fitnesses, std::vector<int>& unknown)
+{
+	const int length = ga.getChromosomeLength();
+	unknown.clear();
+	m_duplicates.clear();
+	m_unknownHash.clear();
+
+	// ̐ŕ]KvɂȂF (nbVl̑O̂̃CfbNX)
+	std::unordered_map<uint64_t, int> pending;
+	for (int i = 0; i < ga.getPopulation(); ++i)
+	{
+		const Gene* chromosome = ga.getIndividual(i);
+		uint64_t hash[2];
+		computeHash(chromosome, length, hash);
+		if (find(hash, fitnesses[i]))
+			continue;
+
+		auto it = pending.find(hash[0]);
+		if (it != pending.end() && memcmp(ga.getIndividual(it->second), chromosome, sizeof(Gene) * length) == 0)
+		{
+			m_duplicates.emplace_back(i, it->second);
+			++m_statistics.duplicateNum;
+			continue;
+		}
+		pending.emplace(hash[0], i);
+		unknown.push_back(i);
+		m_unknownHash.push_back(hash[0]);
+		m_unknownHash.push_back(hash[1]);
+	}
+	return static_cast<int>(unknown.size());
+}
+
+template<typename Gene, typename Fitness>
+inline void FitnessCache<Gene, Fitness>::store(const GeneticAlgorithm<Gene, Fitness>& ga, Fitness* fitnesses, const std::vector<int>& unknown)
+{
+	// lookup֐ŋ߂nbVlg
+	const int length = ga.getChromosomeLength();
+	const bool reuse = m_unknownHash.size() == unknown.size() * 2;
+	for (size_t i = 0; i < unknown.size(); ++i)
+	{
+		if (reuse)
+			insert(&m_unknownHash[i * 2], fitnesses[unknown[i]]);
+		else
+			insert(ga.getIndividual(unknown[i]), length, fitnesses[unknown[i]]);
+	}
+	for (const auto& duplicate : m_duplicates)
+		fitnesses[duplicate.first] = fitnesses[duplicate.second];
+	m_duplicates.clear();
+	m_unknownHash.clear();
+}
+
+template<typename Gene, typename Fitness>
+template<typename Function>
+inline void FitnessCache<Gene, Fitness>::evaluate(GeneticAlgorithm<Gene, Fitness>& ga, Function function)
+{
+	if (m_fitnessesSize != ga.getPopulation())
+	{
+		m_fitnesses.reset(new Fitness[ga.getPopulation()]);
+		m_fitnessesSize = ga.getPopulation();
+	}
+
+	lookup(ga, m_fitnesses.get(), m_unknown);
+	for (int index : m_unknown)
+		m_fitnesses[index] = function(index, ga.getIndividual(index));
+	store(ga, m_fitnesses.get(), m_unknown);
+
+	ga.evaluate(m_fitnesses.get());
+}
+
+template<typename Gene, typename Fitness>
+inline FitnessCacheStatistics FitnessCache<Gene, Fitness>::getStatistics() const
+{
+	FitnessCacheStatistics statistics = m_statistics;
+	statistics.size = m_size;
+	statistics.capacity = m_capacity;
+	return statistics;
+}
+
+template<typename Gene, typename Fitness>
+inline void FitnessCache<Gene, Fitness>::computeHash(const Gene* chromosome, int length, uint64_t hash[2])
+{
+	constexpr uint64_t K0 = 0x9e3779b97f4a7c15ull;
+	constexpr uint64_t K1 = 0xc2b2ae3d27d4eb4full;
+	constexpr uint64_t K2 = 0x165667b19e3779f9ull;
+
+	auto rotl = [](uint64_t x, int r) { return (x << r) | (x >> (64 - r)); };
+	auto mix = [](uint64_t x)
+	{
+		// splitmix64̍Ō̊ha
+		x ^= x >> 30;
+		x *= 0xbf58476d1ce4e5b9ull;
+		x ^= x >> 27;
+		x *= 0x94d049bb133111ebull;
+		x ^= x >> 31;
+		return x;
+	};
+
+	// Q̓Ɨnň`q̃rbg
+	uint64_t h0 = K0 ^ static_cast<uint64_t>(length);
+	uint64_t h1 = K1 + static_cast<uint64_t>(length);
+	for (int i = 0; i < length; ++i)
+	{
+		uint64_t v = 0;
+		memcpy(&v, &chromosome[i], sizeof(Gene));
+		h0 = rotl(h0 ^ (v * K1), 31) * K0;
+		h1 = rotl(h1 + (v * K2), 27) * K1 + K0;
+	}
+	hash[0] = mix(h0 ^ rotl(h1, 17));
+	hash[1] = mix(h1 + K2);
+}
+
+template<typename Gene, typename Fitness>
+inline int FitnessCache<Gene, Fitness>::getFreeSlot()
+{
+	if (m_size < m_capacity)
+		return m_size++;
+
+	// ŋ߈ꂽ̂͂PAĂȂ̂ǂo
+	while (m_entries[m_hand].referenced)
+	{
+		m_entries[m_hand].referenced = false;
+		m_hand = (m_hand + 1) % m_capacity;
+	}
+
+	const int slot = m_hand;
+	m_hand = (m_hand + 1) % m_capacity;
+	m_index.erase(m_entries[slot].hash[0]);
+	++m_statistics.evictionNum;
+	return slot;
+}
@@ -0,0 +1,303 @@
+#pragma once
+
+#include "NeuralNetwork.h"
+#include "ActFncOperator.h"
+#include "Random.h"
+#include "SimdKernel.h"
+#include <array>
+#include <tuple>
+#include <utility>
+#include <cstring>
+
+/*
+* FixedNeuralNetwork̒ԑwEo͑w̐ݒ
+*
+* template<int Size, ActFncID ActFnc, ActFncPrecision Precision>
+* Size      m[h (oCAXm[h܂܂Ȃ)
+* ActFnc    ֐ID
+* Precision ֐̌vZ̐x (SigmoidTanĥ݉e)
+*/
+template<int Size, ActFncID ActFnc, ActFncPrecision Precision = ActFncPrecision::EXACT>
+struct FixedLayer
+{
+	static_assert(Size > 0, "FixedLayer size must be positive");
+
+	static constexpr int SIZE = Size;
+	static constexpr ActFncID ACT_FNC_ID = ActFnc;
+	static constexpr ActFncPrecision PRECISION = Precision;
+};
+
+/*
+* template<typename T, int InputSize, typename... Layers>
+* T         ́EóEď݂^ intEfloatEdouble
+* InputSize ͑w̃m[h (oCAXm[h܂܂Ȃ)
+* Layers    ԑwEo͑wFixedLayer (͑wɋ߂珇ɕׁAŌオo͑w Qȏ)
+*
+* w̑傫Ɗ֐RpCɌ߂NeuralNetwork
+*     using XorNetwork = FixedNeuralNetwork<int, 2, FixedLayer<2, ActFncID::RELU>, FixedLayer<1, ActFncID::STEP>>;
+*
+* d݂Ƒw̒l͑Sstd::arrayɎAq[v̊mۂz֐̌ĂяoȂ
+* Ȏw̃m[hUNROLL_LIMITȉ̐Ϙa͊SɓWJ
+*
+* d݂̕тNeuralNetworkƓȂ̂ŁAGeneticAlgorithm̌̂̂܂setWeight֐ɓn
+* NeuralNetworkƂ̕ϊfromNeuralNetwork֐EtoNeuralNetwork֐A
+* t@Co͂LAFileIONeuralNetworkƓ`ōs
+*
+* _ŎgpłAd݂0ŏ
+*/
+template<typename T, int InputSize, typename... Layers>
+class FixedNeuralNetwork
+{
+	static_assert(std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double>, "FixedNeuralNetwork template is only int, float or double");
+	static_assert(InputSize > 0, "FixedNeuralNetwork input size must be positive");
+	static_assert(sizeof...(Layers) >= 2, "FixedNeuralNetwork needs at least one hidden layer and an output layer");
+
+	// ͑wo͑w܂ł̃m[h
+	static constexpr std::array<int, sizeof...(Layers) + 1> SIZES = { InputSize, Layers::SIZE... };
+
+	static constexpr int computeWeightSize()
+	{
+		int size = 0;
+		for (size_t i = 0; i + 1 < SIZES.size(); ++i)
+			size += (SIZES[i] + 1) * SIZES[i + 1];
+		return size;
+	}
+
+public:
+	static constexpr int INPUT_LAYER_SIZE = InputSize;
+	static constexpr int HIDDEN_LAYER_NUM = sizeof...(Layers) - 1;
+	static constexpr int OUTPUT_LAYER_SIZE = SIZES.back();
+	static constexpr int WEIGHT_SIZE = computeWeightSize();
+
+	// Ȏw̃m[hȉ̐Ϙa͊SɓWJ (傫wSimdKernel::dot֐g)
+	static constexpr int UNROLL_LIMIT = 32;
+
+public:
+	FixedNeuralNetwork();
+	~FixedNeuralNetwork();
+
+public:
+	/*
+	* d݂̐ݒ
+	*
+	* @param weight d݂̔z TCY = WEIGHT_SIZE
+	*/
+	void setWeight(const T* weight);
+
+	/*
+	* d݂_ɐݒ
+	*
+	* @param min    _̍ŏl (܂)
+	* @param max    _̍ől (܂)
+	* @param random 
+	*/
+	void setWeightRandom(T min, T max, Random& random);
+
+	/*
+	* `dē͂o͂𓾂
+	*
+	* @param input ͔z TCY = INPUT_LAYER_SIZE
+	* @return o͔z TCY = OUTPUT_LAYER_SIZE
+	*/
+	const T* forwardPropagation(const T* input);
+
+	/*
+	* `dē͂o͂𓾂 (̃Xbh瓯ɌĂяo)
+	*
+	* @param input  ͔z TCY = INPUT_LAYER_SIZE
+	* @param output o͔z TCY = OUTPUT_LAYER_SIZE
+	*/
+	void forwardPropagation(const T* input, T* output) const;
+
+	/*
+	* ̓͂ɏ`dďo͂𓾂
+	*
+	* @param input     ͔z TCY = sampleNum * INPUT_LAYER_SIZE
+	* @param sampleNum ͂̐
+	* @param output    o͔z TCY = sampleNum * OUTPUT_LAYER_SIZE
+	*/
+	void forwardPropagation(const T* input, int sampleNum, T* output) const;
+
+	/*
+	* nn̏d݂ǂݍ
+	*
+	* @param nn D܂Őݒ肵NeuralNetwork
+	* @return w̑傫E֐ExvȂꍇfalse (̏ꍇ͉ύXȂ)
+	*/
+	bool fromNeuralNetwork(const NeuralNetwork<T>& nn);
+
+	/*
+	* \Əd݂NeuralNetwork
+	*
+	* @param nn ݐ (܂ł̏Ԃ͔j)
+	*/
+	void toNeuralNetwork(NeuralNetwork<T>& nn) const;
+
+	// @return nn̑w̑傫E֐Ex̃NXƈvꍇtrue
+	static bool matches(const NeuralNetwork<T>& nn);
+
+	// @return d݂̔z TCY = WEIGHT_SIZE
+	const T* getWeight() const;
+
+private:
+	/*
+	* NԖڂ̑w (0͍ŏ̒ԑw) o͑w܂ł`d
+	*
+	* @param src    Ȏw̒l TCY = SIZES[N]
+	* @param weight NԖڂ̑w̏d
+	* @param output o͔z TCY = OUTPUT_LAYER_SIZE
+	*/
+	template<size_t N>
+	static void propagate(const T* src, const T* weight, T* output);
+
+	/*
+	* oCAX܂߂ȎwƏd݂̂Ps̐Ϙa
+	*
+	* @param src Ȏw̒l TCY = SrcSize
+	* @param row d݂̂Ps TCY = SrcSize + 1 (ŌオoCAX)
+	*/
+	template<int SrcSize>
+	static T dot(const T* src, const T* row);
+
+	template<int SrcSize, size_t... I>
+	static T dotUnrolled(const T* src, const T* row, std::index_sequence<I...>);
+
+private:
+	std::array<T, WEIGHT_SIZE> m_weight;
+	std::array<T, OUTPUT_LAYER_SIZE> m_output;
+};
+
+
+
+
+template<typename T, int InputSize, typename... Layers>
+inline FixedNeuralNetwork<T, InputSize, Layers...>::FixedNeuralNetwork()
+	: m_weight()
+	, m_output()
+{
+}
+
+template<typename T, int InputSize, typename... Layers>
+inline FixedNeuralNetwork<T, InputSize, Layers...>::~FixedNeuralNetwork()
+{
+}
+
+template<typename T, int InputSize, typename... Layers>
+inline void FixedNeuralNetwork<T, InputSize, Layers...>::setWeight(const T* weight)
+{
+	memcpy(m_weight.data(), weight, sizeof(T) * WEIGHT_SIZE);
+}
+
+template<typename T, int InputSize, typename... Layers>
+inline void FixedNeuralNetwork<T, InputSize, Layers...>::setWeightRandom(T min, T max, Random& random)
+{
+	random.fill(m_weight.data(), WEIGHT_SIZE, min, max);
+}
+
+template<typename T, int InputSize, typename... Layers>
+inline const T* FixedNeuralNetwork<T, InputSize, Layers...>::forwardPropagation(const T* input)
+{
+	forwardPropagation(input, m_output.data());
+	return m_output.data();
+}
+
+template<typename T, int InputSize, typename... Layers>
+inline void FixedNeuralNetwork<T, InputSize, Layers...>::forwardPropagation(const T* input, T* output) const
+{
+	propagate<0>(input, m_weight.data(), output);
+}
+
+template<typename T, int InputSize, typename... Layers>
+inline void FixedNeuralNetwork<T, InputSize, Layers...>::forwardPropagation(const T* input, int sampleNum, T* output) const
+{
+	for (int s = 0; s < sampleNum; ++s)
+		propagate<0>(&input[s * INPUT_LAYER_SIZE], m_weight.data(), &output[s * OUTPUT_LAYER_SIZE]);
+}
+
+template<typename T, int InputSize, typename... Layers>
+inline bool FixedNeuralNetwork<T, InputSize, Layers...>::fromNeuralNetwork(const NeuralNetwork<T>& nn)
+{
+	if (!matches(nn))
+		return false;
+
+	setWeight(nn.getWeight());
+	return true;
+}
+
+template<typename T, int InputSize, typename... Layers>
+inline void FixedNeuralNetwork<T, InputSize, Layers...>::toNeuralNetwork(NeuralNetwork<T>& nn) const
+{
+	constexpr ActFncID ACT_FNC_IDS[] = { Layers::ACT_FNC_ID... };
+	constexpr ActFncPrecision PRECISIONS[] = { Layers::PRECISION... };
+
+	nn.clear();
+	nn.setInputLayer(INPUT_LAYER_SIZE);
+	nn.setHiddenLayerNum(HIDDEN_LAYER_NUM);
+	for (int i = 0; i < HIDDEN_LAYER_NUM; ++i)
+		nn.setHiddenLayer(SIZES[i + 1], ACT_FNC_IDS[i], PRECISIONS[i]);
+	nn.setOutputLayer(OUTPUT_LAYER_SIZE, ACT_FNC_IDS[HIDDEN_LAYER_NUM], PRECISIONS[HIDDEN_LAYER_NUM]);
+	nn.setWeight(m_weight.data());
+}
+
+template<typename T, int InputSize, typename... Layers>
+inline bool FixedNeuralNetwork<T, InputSize, Layers...>::matches(const NeuralNetwork<T>& nn)
+{
+	constexpr ActFncID ACT_FNC_IDS[] = { Layers::ACT_FNC_ID... };
+	constexpr ActFncPrecision PRECISIONS[] = { Layers::PRECISION... };
+
+	if (nn.getInputLayerSize() != INPUT_LAYER_SIZE || nn.getHiddenLayerNum() != HIDDEN_LAYER_NUM)
+		return false;
+	for (int i = 0; i < HIDDEN_LAYER_NUM; ++i)
+	{
+		if (nn.getHiddenLayerSize(i) != SIZES[i + 1] || nn.getHiddenLayerActFncID(i) != ACT_FNC_IDS[i] || nn.getHiddenLayerActFncPrecision(i) != PRECISIONS[i])
+			return false;
+	}
+	return nn.getOutputLayerSize() == OUTPUT_LAYER_SIZE
+		&& nn.getOutputLayerActFncID() == ACT_FNC_IDS[HIDDEN_LAYER_NUM]
+		&& nn.getOutputLayerActFncPrecision() == PRECISIONS[HIDDEN_LAYER_NUM];
+}
+
+template<typename T, int InputSize, typename... Layers>
+inline const T* FixedNeuralNetwork<T, InputSize, Layers...>::getWeight() const
+{
+	return m_weight.data();
+}
+
+template<typename T, int InputSize, typename... Layers>
+template<size_t N>
+inline void FixedNeuralNetwork<T, InputSize, Layers...>::propagate(const T* src, const T* weight, T* output)
+{
+	using Layer = std::tuple_element_t<N, std::tuple<Layers...>>;
+	constexpr int SRC_SIZE = SIZES[N];
+	constexpr bool LAST = N + 1 == sizeof...(Layers);
+
+	// ԑw̒l̓X^bNɒuAo͑w͒outputɏ
+	std::array<T, LAST ? 1 : Layer::SIZE> layer;
+	T* dst = LAST ? output : layer.data();
+
+	for (int d = 0; d < Layer::SIZE; ++d)
+		dst[d] = dot<SRC_SIZE>(src, &weight[d * (SRC_SIZE + 1)]);
+	ActFncOperator::apply<Layer::ACT_FNC_ID>(dst, Layer::SIZE, Layer::PRECISION);
+
+	if constexpr (!LAST)
+		propagate<N + 1>(dst, weight + Layer::SIZE * (SRC_SIZE + 1), output);
+}
+
+template<typename T, int InputSize, typename... Layers>
+template<int SrcSize>
+inline T FixedNeuralNetwork<T, InputSize, Layers...>::dot(const T* src, const T* row)
+{
+	if constexpr (SrcSize <= UNROLL_LIMIT)
+		return dotUnrolled<SrcSize>(src, row, std::make_index_sequence<SrcSize>());
+	else
+		return SimdKernel::dot(src, row, SrcSize) + row[SrcSize];
+}
+
+template<typename T, int InputSize, typename... Layers>
+template<int SrcSize, size_t... I>
+inline T FixedNeuralNetwork<T, InputSize, Layers...>::dotUnrolled(const T* src, const T* row, std::index_sequence<I...>)
+{
+	T sum = row[SrcSize];
+	((sum += src[I] * row[I]), ...);
+	return sum;
+}
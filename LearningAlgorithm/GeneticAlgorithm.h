@@ -1,13 +1,19 @@
 #pragma once
 
 #include "Random.h"
+#include "Selection.h"
+#include "Telemetry.h"
 #include <memory>
 #include <algorithm>
+#include <cstring>
+#include <vector>
+#include <thread>
+#include <atomic>
 
 /*
 * template<typename Gene, typename Fitness>
-* Gene    F̂̌^ intdouble
-* Fitness Kx̌^ intdouble
+* Gene    F̂̌^ intEfloatEdouble
+* Fitness Kx̌^ intEfloatEdouble
 * 
 * ̃NX̐܂clear֐Ă񂾏Ԃł
 * ܂reset֐s邱
@@ -18,8 +24,8 @@
 template<typename Gene, typename Fitness>
 class GeneticAlgorithm
 {
-	static_assert(std::is_same_v<Gene, int> || std::is_same_v<Gene, double>, "GeneticAlgorithm template is only int or double");
-	static_assert(std::is_same_v<Fitness, int> || std::is_same_v<Fitness, double>, "GeneticAlgorithm template is only int or double");
+	static_assert(std::is_same_v<Gene, int> || std::is_same_v<Gene, float> || std::is_same_v<Gene, double>, "GeneticAlgorithm template is only int, float or double");
+	static_assert(std::is_same_v<Fitness, int> || std::is_same_v<Fitness, float> || std::is_same_v<Fitness, double>, "GeneticAlgorithm template is only int, float or double");
 
 public:
 	GeneticAlgorithm();
@@ -67,6 +73,14 @@ public:
 	*/
 	void setIndividualsRandom(Gene min, Gene max);
 
+	/*
+	* P̂̐F̂̓eݒ肷
+	* 
+	* @param index      ̂̃CfbNX
+	* @param chromosome F̂̔z TCY = F̂̒
+	*/
+	void setIndividual(int index, const Gene* chromosome);
+
 	/*
 	* S̂̓Kxݒ肷
 	* 
@@ -85,6 +99,70 @@ public:
 	*/
 	void generateNextGeneration();
 
+	/*
+	* ȇI@̐ݒ
+	* 
+	* e̓G[g̈ȊOI
+	* 
+	* @param id             I@ID (l = ROULETTE)
+	* @param tournamentSize g[igIłPɔׂ̐ (Qȏ)
+	*/
+	void setSelection(SelectionID id, int tournamentSize = 2);
+
+	// @return ȇI@ID
+	SelectionID getSelection() const;
+
+	// @return g[igIłPɔׂ̐
+	int getTournamentSize() const;
+
+	/*
+	* ̃V[h̐ݒ
+	* 
+	* V[hݒ肷΁AKx瓯オ
+	* ݒ肵Ȃꍇstd::random_device瓾V[hg
+	* 
+	* @param seed V[h
+	*/
+	void setSeed(uint64_t seed);
+
+	// @return ̃V[h (ݒ肵ȂꍇsetSeed֐ɓnΓČł)
+	uint64_t getSeed() const;
+
+	/*
+	* ̓Ԃ̐ݒ
+	* 
+	* setSeed֐̌ɌĂсAۑĂԂ痐ĊJ
+	* 
+	* @param state getRandomState֐œ
+	*/
+	void setRandomState(const Random::State& state);
+
+	// @return ̓ (ۑEp)
+	Random::State getRandomState() const;
+
+	/*
+	* 𐶐Xbh̐ݒ
+	* 
+	* q͐ƌ̂̃CfbNXƂɓƗŐ邽
+	* Xbhɂ炸AV[h͓オ
+	* 
+	* @param num Xbh Pȏ (l = 1)
+	*/
+	void setThreadNum(int num);
+
+	/*
+	* ԂL^̐ݒ
+	* 
+	* LA_TELEMETRY`ăRpCꍇ̂ݓA`Ȃꍇ͉Ȃ
+	* ̏ItelemetryendGeneration֐Ă
+	* 
+	* @param telemetry L^ (nullptrŋL^Ȃ) ̃NXgI܂ŕێ邱
+	*/
+	void setTelemetry(Telemetry* telemetry);
+
+	// @return 𐶐Xbh
+	int getThreadNum() const;
+
 	// @return ݂̐㐔 (1-based)
 	int getGeneration() const;
 
@@ -123,6 +201,44 @@ private:
 	std::unique_ptr<Gene[]> m_individualsTmp;
 	std::unique_ptr<Fitness[]> m_fitnesses;
 	std::unique_ptr<int[]> m_sortIndex;
+	Selection<Fitness> m_selection;
+	Random m_random;
+	uint64_t m_seed;
+	int m_threadNum;
+	std::unique_ptr<double[]> m_uniform;
+#if defined(LA_TELEMETRY)
+	Telemetry* m_telemetry;
+	TelemetryTimer m_evaluationTimer;
+#endif
+
+	/*
+	* ̎q𐶐闐
+	* 
+	* qƂɓƗgƂŁAXbhɂ炸ʂɂȂ
+	* 
+	* @param index ɂq̃CfbNX
+	*/
+	Random getChildRandom(int index) const;
+
+	/*
+	* eQ̑I
+	* 
+	* @param random q̗
+	* @param parent Ie̐F̂̏ݐ
+	*/
+	void selectParents(Random& random, const Gene* parent[2]) const;
+
+	/*
+	* Ŏ̎qP̐
+	* 
+	* ̐F͓̂ǂނȂ̂ŁAقȂindexłΓɌĂяo
+	* 
+	* @param index   ɂq̃CfbNX
+	* @param parent  e̐F
+	* @param random  q̗ (selectParents֐Ŏg)
+	* @param uniform Ɨ̈ TCY = F̂̒
+	*/
+	void crossover(int index, const Gene* const parent[2], Random& random, double* uniform) const;
 };
 
 
@@ -140,7 +256,19 @@ inline GeneticAlgorithm<Gene, Fitness>::GeneticAlgorithm()
 	, m_individualsTmp()
 	, m_fitnesses()
 	, m_sortIndex()
+	, m_selection()
+	, m_random()
+	, m_seed()
+	, m_threadNum(1)
+	, m_uniform()
+#if defined(LA_TELEMETRY)
+	, m_telemetry()
+	, m_evaluationTimer()
+#endif
 {
+	// setSeed(getSeed())œɖ߂悤ɁAm_randomV[h蒼
+	m_seed = Random()();
+	m_random.seed(m_seed);
 }
 
 template<typename Gene, typename Fitness>
@@ -161,6 +289,7 @@ inline void GeneticAlgorithm<Gene, Fitness>::clear()
 	m_individualsTmp.reset();
 	m_fitnesses.reset();
 	m_sortIndex.reset();
+	m_uniform.reset();
 }
 
 template<typename Gene, typename Fitness>
@@ -174,8 +303,9 @@ inline void GeneticAlgorithm<Gene, Fitness>::reset(int population, int chromosom
 	m_eliteNum = eliteNum;
 	m_individuals.reset(new Gene[population * chromosomeLength]);
 	m_individualsTmp.reset(new Gene[population * chromosomeLength]);
-	m_fitnesses.reset(new Gene[population]);
+	m_fitnesses.reset(new Fitness[population]);
 	m_sortIndex.reset(new int[population]);
+	m_uniform.reset(new double[m_threadNum * chromosomeLength]);
 
 	for (int i = 0; i < population; ++i)
 		m_sortIndex[i] = i;
@@ -190,89 +320,247 @@ inline void GeneticAlgorithm<Gene, Fitness>::setIndividuals(const Gene* individu
 template<typename Gene, typename Fitness>
 inline void GeneticAlgorithm<Gene, Fitness>::setIndividualsRandom(Gene min, Gene max)
 {
-	auto random = Random<Gene>();
+	m_random.fill(m_individuals.get(), m_population * m_chromosomeLength, min, max);
+}
 
-	int size = m_population * m_chromosomeLength;
-	for (int i = 0; i < size; ++i)
-		m_individuals[i] = random(min, max);
+template<typename Gene, typename Fitness>
+inline void GeneticAlgorithm<Gene, Fitness>::setIndividual(int index, const Gene* chromosome)
+{
+	memcpy(&m_individuals[index * m_chromosomeLength], chromosome, sizeof(Gene) * m_chromosomeLength);
 }
 
 template<typename Gene, typename Fitness>
 inline void GeneticAlgorithm<Gene, Fitness>::evaluate(const Fitness* fitnesses)
 {
 	memcpy(m_fitnesses.get(), fitnesses, sizeof(Fitness) * m_population);
+
+#if defined(LA_TELEMETRY)
+	// O̐̏I肩]̎ԂƂ
+	int64_t evaluationTime = m_evaluationTimer.lap();
+	if (m_telemetry)
+		m_telemetry->record(TelemetryPhase::EVALUATION, evaluationTime);
+#endif
 }
 
 template<typename Gene, typename Fitness>
 inline void GeneticAlgorithm<Gene, Fitness>::generateNextGeneration()
 {
+#if defined(LA_TELEMETRY)
+	TelemetryTimer timer;
+	int64_t swapTime = 0;
+#endif
+
 	for (int i = 0; i < m_population; ++i)
 		m_sortIndex[i] = i;
 
-	// Kx傫Ƀ\[g
-	std::sort(m_sortIndex.get(), m_sortIndex.get() + m_population, [this](int lhs, int rhs)
+	// Kx傫ɃG[g̐\[g
+	std::partial_sort(m_sortIndex.get(), m_sortIndex.get() + m_eliteNum, m_sortIndex.get() + m_population, [this](int lhs, int rhs)
 		{ return m_fitnesses[lhs] > m_fitnesses[rhs]; }
 	);
 
+#if defined(LA_TELEMETRY)
+	if (m_telemetry)
+		m_telemetry->record(TelemetryPhase::SORT, timer.lap());
+#endif
+
 	// ɃG[gz
 	for (int i = 0; i < m_eliteNum; ++i)
 		memcpy(&m_individualsTmp[i * m_chromosomeLength], &m_individuals[m_sortIndex[i] * m_chromosomeLength], sizeof(Gene) * m_chromosomeLength);
 
-	// Kx̍vlvZ ([bgIɎg)
-	Fitness fitnessBase = (-m_fitnesses[m_sortIndex[m_population - 1]]) + 1;
-	Fitness fitnessSum = 0;
-	for (int i = m_eliteNum; i < m_population; ++i)
-		fitnessSum += m_fitnesses[m_sortIndex[i]] + fitnessBase;
+#if defined(LA_TELEMETRY)
+	swapTime += timer.lap();
+#endif
 
-	auto rndF = Random<Fitness>();
+	// G[gȊOěƂ
+	// (\[ǧ̌̕т͌܂ĂȂ̂ŁAŜ\[gĂƂ͓V[hłI΂eقȂ)
+	if (m_eliteNum < m_population)
+	{
+		Fitness minFitness = *std::min_element(m_fitnesses.get(), m_fitnesses.get() + m_population);
+		m_selection.prepare(m_fitnesses.get(), &m_sortIndex[m_eliteNum], m_population - m_eliteNum, minFitness);
+	}
+
+#if defined(LA_TELEMETRY)
+	// etF[YゲƂɂP̒lɂȂ悤ɁAXbhƂ̎Ԃ͍vĂL^
+	std::atomic<int64_t> selectionTotal(timer.lap());
+	std::atomic<int64_t> crossoverTotal(0);
+#endif
 
-	// ̌̂P[vɕtP̐
-	for (int i = m_eliteNum; i < m_population; ++i)
+	// ̌̂XbhƂɕSĐ
+	const int childNum = m_population - m_eliteNum;
+	const int threadNum = std::max(1, std::min(m_threadNum, childNum));
+	auto generateChildren = [&](int t)
 	{
-		// [bgIłQ̑I
-		Gene* indv[2] = {};
-		for (int j = 0; j < 2; ++j)
-		{
-			Fitness r = rndF(0, fitnessSum);
-			for (int k = m_eliteNum; k < m_population - 1; ++k)
-			{
-				r -= m_fitnesses[m_sortIndex[k]] + fitnessBase;
-				if (r <= 0)
-				{
-					indv[j] = &m_individuals[m_sortIndex[k] * m_chromosomeLength];
-					break;
-				}
-			}
-			if (indv[j] == nullptr)
-				indv[j] = &m_individuals[m_sortIndex[m_population - 1] * m_chromosomeLength];
-		}
+		int begin = m_eliteNum + static_cast<int>(static_cast<int64_t>(childNum) * t / threadNum);
+		int end = m_eliteNum + static_cast<int>(static_cast<int64_t>(childNum) * (t + 1) / threadNum);
+		double* uniform = &m_uniform[t * m_chromosomeLength];
 
-		auto rndG = Random<Gene>();
-		Gene* secondIndv = &m_individualsTmp[i * m_chromosomeLength];
+#if defined(LA_TELEMETRY)
+		TelemetryTimer timer;
+		int64_t selectionTime = 0;
+		int64_t crossoverTime = 0;
+#endif
 
-		// uh (BLX-)
-		for (int j = 0; j < m_chromosomeLength; ++j)
+		for (int i = begin; i < end; ++i)
 		{
-			Gene diff = std::abs(indv[0][j] - indv[1][j]) / 2;
-			if constexpr (std::is_same_v<Gene, int>)
-			{
-				if (diff == 0)
-					diff = 1;
-			}
-			else
-			{
-				if (diff < std::numeric_limits<double>::epsilon() * 2.0)
-					diff = std::numeric_limits<double>::epsilon() * 2.0;
-			}
-			Gene min = std::max(m_chromosomeValueMin, std::min(indv[0][j], indv[1][j]) - diff);
-			Gene max = std::min(m_chromosomeValueMax, std::max(indv[0][j], indv[1][j]) + diff);
-			secondIndv[j] = rndG(min, max);
+			Random random = getChildRandom(i);
+			const Gene* parent[2] = {};
+			selectParents(random, parent);
+#if defined(LA_TELEMETRY)
+			selectionTime += timer.lap();
+#endif
+			crossover(i, parent, random, uniform);
+#if defined(LA_TELEMETRY)
+			crossoverTime += timer.lap();
+#endif
 		}
+
+#if defined(LA_TELEMETRY)
+		selectionTotal += selectionTime;
+		crossoverTotal += crossoverTime;
+#endif
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(threadNum - 1);
+	for (int t = 1; t < threadNum; ++t)
+		threads.emplace_back(generateChildren, t);
+	generateChildren(0);
+	for (auto& thread : threads)
+		thread.join();
+
+#if defined(LA_TELEMETRY)
+	if (m_telemetry)
+	{
+		m_telemetry->record(TelemetryPhase::SELECTION, selectionTotal);
+		m_telemetry->record(TelemetryPhase::CROSSOVER, crossoverTotal);
 	}
+	timer.lap();
+#endif
 
 	// Ƃ
 	m_individuals.swap(m_individualsTmp);
 	++m_generation;
+
+#if defined(LA_TELEMETRY)
+	if (m_telemetry)
+	{
+		m_telemetry->record(TelemetryPhase::SWAP, swapTime + timer.lap());
+		m_telemetry->endGeneration(m_generation - 1);
+	}
+	m_evaluationTimer.lap();
+#endif
+}
+
+template<typename Gene, typename Fitness>
+inline Random GeneticAlgorithm<Gene, Fitness>::getChildRandom(int index) const
+{
+	return Random(m_seed, (static_cast<uint64_t>(m_generation) << 32) | static_cast<uint32_t>(index));
+}
+
+template<typename Gene, typename Fitness>
+inline void GeneticAlgorithm<Gene, Fitness>::selectParents(Random& random, const Gene* parent[2]) const
+{
+	for (int j = 0; j < 2; ++j)
+		parent[j] = &m_individuals[m_selection.select(random) * m_chromosomeLength];
+}
+
+template<typename Gene, typename Fitness>
+inline void GeneticAlgorithm<Gene, Fitness>::crossover(int index, const Gene* const parent[2], Random& random, double* uniform) const
+{
+	// `qƂ̗܂Ƃ߂Đ
+	random.fillCanonical(uniform, m_chromosomeLength);
+
+	Gene* secondIndv = &m_individualsTmp[index * m_chromosomeLength];
+
+	// uh (BLX-)
+	for (int j = 0; j < m_chromosomeLength; ++j)
+	{
+		Gene diff = std::abs(parent[0][j] - parent[1][j]) / 2;
+		if constexpr (std::is_same_v<Gene, int>)
+		{
+			if (diff == 0)
+				diff = 1;
+		}
+		else
+		{
+			if (diff < std::numeric_limits<Gene>::epsilon() * 2)
+				diff = std::numeric_limits<Gene>::epsilon() * 2;
+		}
+		Gene min = std::max(m_chromosomeValueMin, std::min(parent[0][j], parent[1][j]) - diff);
+		Gene max = std::min(m_chromosomeValueMax, std::max(parent[0][j], parent[1][j]) + diff);
+		if constexpr (std::is_integral_v<Gene>)
+			secondIndv[j] = std::min(max, min + static_cast<Gene>(uniform[j] * (max - min + 1)));
+		else
+			secondIndv[j] = min + static_cast<Gene>(uniform[j]) * (max - min);
+	}
+}
+
+template<typename Gene, typename Fitness>
+inline void GeneticAlgorithm<Gene, Fitness>::setThreadNum(int num)
+{
+	m_threadNum = num;
+	if (m_chromosomeLength > 0)
+		m_uniform.reset(new double[m_threadNum * m_chromosomeLength]);
+}
+
+template<typename Gene, typename Fitness>
+inline void GeneticAlgorithm<Gene, Fitness>::setTelemetry(Telemetry* telemetry)
+{
+#if defined(LA_TELEMETRY)
+	m_telemetry = telemetry;
+	m_evaluationTimer.lap();
+#else
+	(void)telemetry;
+#endif
+}
+
+template<typename Gene, typename Fitness>
+inline int GeneticAlgorithm<Gene, Fitness>::getThreadNum() const
+{
+	return m_threadNum;
+}
+
+template<typename Gene, typename Fitness>
+inline void GeneticAlgorithm<Gene, Fitness>::setSelection(SelectionID id, int tournamentSize)
+{
+	m_selection.setMethod(id, tournamentSize);
+}
+
+template<typename Gene, typename Fitness>
+inline SelectionID GeneticAlgorithm<Gene, Fitness>::getSelection() const
+{
+	return m_selection.getMethod();
+}
+
+template<typename Gene, typename Fitness>
+inline int GeneticAlgorithm<Gene, Fitness>::getTournamentSize() const
+{
+	return m_selection.getTournamentSize();
+}
+
+template<typename Gene, typename Fitness>
+inline void GeneticAlgorithm<Gene, Fitness>::setSeed(uint64_t seed)
+{
+	m_seed = seed;
+	m_random.seed(seed);
+}
+
+template<typename Gene, typename Fitness>
+inline uint64_t GeneticAlgorithm<Gene, Fitness>::getSeed() const
+{
+	return m_seed;
+}
+
+template<typename Gene, typename Fitness>
+inline void GeneticAlgorithm<Gene, Fitness>::setRandomState(const Random::State& state)
+{
+	m_random.setState(state);
+}
+
+template<typename Gene, typename Fitness>
+inline Random::State GeneticAlgorithm<Gene, Fitness>::getRandomState() const
+{
+	return m_random.getState();
 }
 
 template<typename Gene, typename Fitness>
@@ -0,0 +1,662 @@
+#pragma once
+
+#include "GeneticAlgorithm.h"
+#include "ModelFile.h"
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <cstring>
+#include <cstdint>
+
+/*
+* GÃ`FbN|CgȌ (oCgI[_[͎s̂܂)
+*
+*   GeneticAlgorithmLogHeader
+*   R[h (GeneticAlgorithmLogRecord + yC[h) ǋLɕׂ
+*
+* SNAPSHOT R[h̃yC[h
+*   S̂̐F (LAFileIO::outputGeneticAlgorithm֐Ɠ)
+*   S̂̓Kx
+*
+* DELTA R[h̃yC[h (ÕR[hƂ̍)
+*   ̂Ƃ
+*     ϒ k
+*       k >= 2 ̏ꍇ ÕR[h (k - 2) Ԗڂ̌̂ƓF (zꂽG[g)
+*       k = 1 ̏ꍇ ĐF̂̂܂ (̕傫Ȃꍇ)
+*       k = 0 ̏ꍇ Ĉ`qƂɒÕR[h̓ʒü`qƂ̍
+*   ̂Ƃ ÕR[h̓̂̓KxƂ̍
+*
+* ͐ł̓WOUỎϒ
+* ł̓rbgXORʂ0̃oCg (oCg + ʂ̃oCg)
+*
+* ݓrŎ~܂ꍇ̖̉ꂽR[h́AɊJɐ؂̂Ă
+*/
+struct GeneticAlgorithmLogHeader
+{
+	static constexpr uint32_t MAGIC = 0x464c414c; // "LALF"
+	static constexpr uint16_t VERSION = 1;
+
+	uint32_t magic;
+	uint16_t version;
+	uint16_t geneType;    // ModelHeader::WeightType
+	uint16_t fitnessType; // ModelHeader::WeightType
+	uint16_t reserved[3];
+};
+
+struct GeneticAlgorithmLogRecord
+{
+	static constexpr uint32_t MAGIC = 0x524c414c; // "LALR"
+
+	enum Type : uint16_t
+	{
+		SNAPSHOT = 1,
+		DELTA = 2
+	};
+
+	uint32_t magic;
+	uint16_t type;
+	uint16_t selection;
+	int32_t generation;
+	int32_t population;
+	int32_t chromosomeLength;
+	int32_t eliteNum;
+	int32_t tournamentSize;
+	int32_t reserved;
+	double chromosomeValueMin;
+	double chromosomeValueMax;
+	uint64_t seed;
+	Random::State random;
+	uint64_t payloadSize;
+	uint64_t checksum; // checksum0Ƃ̃wb_ƃyC[hModelFile::checksum֐̒l
+};
+
+/*
+* template<typename Gene, typename Fitness>
+* Gene    F̂̌^ intEfloatEdouble
+* Fitness Kx̌^ intEfloatEdouble
+*
+* GȀԂ𐢑ゲƂɒǋLĂ`FbN|CgO
+*
+* ̃R[hƂɑS̂ (SNAPSHOT)AȊO͒ÕR[hƂ̍ (DELTA)
+* ̃V[hƏԂL^̂ŁAL^ǂ̐ォłiĊJEČł
+*
+* g (Pゲ)
+*   ga.evaluate(fitnesses);
+*   log.append(ga);
+*   ga.generateNextGeneration();
+*
+* evaluate֐̌ɋL^restore֐ŕAgenerateNextGeneration֐ĂԂ
+* L^Ɠオ
+*/
+template<typename Gene, typename Fitness>
+class GeneticAlgorithmLog
+{
+public:
+	GeneticAlgorithmLog();
+	~GeneticAlgorithmLog();
+
+	GeneticAlgorithmLog(const GeneticAlgorithmLog&) = delete;
+	GeneticAlgorithmLog& operator=(const GeneticAlgorithmLog&) = delete;
+
+public:
+	/*
+	* Ot@CJ
+	*
+	* t@CȂ΍AΑɒǋL
+	*
+	* @param path Ot@C̃pX
+	* @return JȂꍇA^̈قȂ郍Ȍꍇfalse
+	*/
+	bool open(const std::string& path);
+
+	// Ot@C
+	void close();
+
+	/*
+	* SNAPSHOTԊu̐ݒ
+	*
+	* Ԋuقǃt@C͏Ȃ邪Arestore֐œǂރR[h
+	*
+	* @param interval R[h Pȏ (l = 100)
+	*/
+	void setSnapshotInterval(int interval);
+
+	/*
+	* gǎ݂̏ԂǋL
+	*
+	* ÕR[hƐlF̂̒قȂꍇSNAPSHOT
+	*
+	* @param ga L^GA
+	* @return ߂Ȃꍇfalse
+	*/
+	bool append(const GeneticAlgorithm<Gene, Fitness>& ga);
+
+	/*
+	* L^̏Ԃgaɕ
+	*
+	* オL^Ăꍇ͍Ō̂̂g
+	*
+	* @param generation 㐔
+	* @param ga         GA
+	* @return L^ĂȂ̏ꍇAǂݍ߂Ȃꍇfalse
+	*/
+	bool restore(int generation, GeneticAlgorithm<Gene, Fitness>& ga);
+
+	// @return L^R[h̐
+	int getRecordNum() const;
+
+	// @return indexԖ(0-based)̃R[h̐㐔
+	int getRecordGeneration(int index) const;
+
+private:
+	struct Entry
+	{
+		int generation;
+		int population;
+		int chromosomeLength;
+		uint16_t type;
+		uint64_t offset;
+	};
+
+	bool scan();
+	bool read(int index, GeneticAlgorithmLogRecord& record, Gene* individuals, Fitness* fitnesses);
+	void encodeDelta(const GeneticAlgorithm<Gene, Fitness>& ga);
+	bool decodeDelta(const char* data, const char* end, int population, int chromosomeLength, Gene* individuals, Fitness* fitnesses);
+	void reserve(int population, int chromosomeLength);
+
+	template<typename T>
+	static void encodeValue(std::vector<char>& out, T value, T base);
+
+	template<typename T>
+	static bool decodeValue(const char*& data, const char* end, T& value);
+
+	static void writeVarint(std::vector<char>& out, uint64_t value);
+	static bool readVarint(const char*& data, const char* end, uint64_t& value);
+
+private:
+	std::string m_path;
+	std::ofstream m_ofs;
+	std::ifstream m_ifs;
+	std::vector<Entry> m_entries;
+	uint64_t m_end;
+	int m_snapshotInterval;
+	int m_sinceSnapshot;
+	int m_population;
+	int m_chromosomeLength;
+	std::unique_ptr<Gene[]> m_individuals;
+	std::unique_ptr<Fitness[]> m_fitnesses;
+	std::vector<Gene> m_base;
+	std::vector<char> m_payload;
+	std::unordered_map<uint64_t, int> m_chromosomeIndex;
+};
+
+
+
+
+template<typename Gene, typename Fitness>
+inline GeneticAlgorithmLog<Gene, Fitness>::GeneticAlgorithmLog()
+	: m_path()
+	, m_ofs()
+	, m_ifs()
+	, m_entries()
+	, m_end()
+	, m_snapshotInterval(100)
+	, m_sinceSnapshot()
+	, m_population()
+	, m_chromosomeLength()
+	, m_individuals()
+	, m_fitnesses()
+	, m_base()
+	, m_payload()
+	, m_chromosomeIndex()
+{
+}
+
+template<typename Gene, typename Fitness>
+inline GeneticAlgorithmLog<Gene, Fitness>::~GeneticAlgorithmLog()
+{
+	close();
+}
+
+template<typename Gene, typename Fitness>
+inline bool GeneticAlgorithmLog<Gene, Fitness>::open(const std::string& path)
+{
+	close();
+	m_path = path;
+
+	// Ȃ΃wb_̃O
+	std::error_code error;
+	if (!std::filesystem::exists(path, error) || std::filesystem::file_size(path, error) == 0)
+	{
+		GeneticAlgorithmLogHeader header = {};
+		header.magic = GeneticAlgorithmLogHeader::MAGIC;
+		header.version = GeneticAlgorithmLogHeader::VERSION;
+		header.geneType = ModelFile::weightType<Gene>();
+		header.fitnessType = ModelFile::weightType<Fitness>();
+		std::ofstream ofs(path, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!ofs.write(reinterpret_cast<const char*>(&header), sizeof(header)))
+			return false;
+	}
+
+	m_ifs.open(path, std::ios::in | std::ios::binary);
+	if (!m_ifs || !scan())
+	{
+		close();
+		return false;
+	}
+
+	m_ofs.open(path, std::ios::out | std::ios::binary | std::ios::app);
+	if (!m_ofs)
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+template<typename Gene, typename Fitness>
+inline void GeneticAlgorithmLog<Gene, Fitness>::close()
+{
+	if (m_ofs.is_open())
+		m_ofs.close();
+	if (m_ifs.is_open())
+		m_ifs.close();
+	m_entries.clear();
+	m_sinceSnapshot = 0;
+	m_population = 0;
+	m_chromosomeLength = 0;
+}
+
+template<typename Gene, typename Fitness>
+inline void GeneticAlgorithmLog<Gene, Fitness>::setSnapshotInterval(int interval)
+{
+	m_snapshotInterval = interval;
+}
+
+template<typename Gene, typename Fitness>
+inline bool GeneticAlgorithmLog<Gene, Fitness>::append(const GeneticAlgorithm<Gene, Fitness>& ga)
+{
+	if (!m_ofs.is_open())
+		return false;
+
+	const int population = ga.getPopulation();
+	const int chromosomeLength = ga.getChromosomeLength();
+	const bool snapshot = m_entries.empty() || m_sinceSnapshot + 1 >= m_snapshotInterval || population != m_population || chromosomeLength != m_chromosomeLength;
+
+	GeneticAlgorithmLogRecord record = {};
+	record.magic = GeneticAlgorithmLogRecord::MAGIC;
+	record.type = snapshot ? GeneticAlgorithmLogRecord::SNAPSHOT : GeneticAlgorithmLogRecord::DELTA;
+	record.selection = static_cast<uint16_t>(ga.getSelection());
+	record.generation = ga.getGeneration();
+	record.population = population;
+	record.chromosomeLength = chromosomeLength;
+	record.eliteNum = ga.getEliteNum();
+	record.tournamentSize = ga.getTournamentSize();
+	record.chromosomeValueMin = static_cast<double>(ga.getChromosomeValueMin());
+	record.chromosomeValueMax = static_cast<double>(ga.getChromosomeValueMax());
+	record.seed = ga.getSeed();
+	record.random = ga.getRandomState();
+
+	m_payload.clear();
+	if (snapshot)
+	{
+		const size_t individualsSize = sizeof(Gene) * population * chromosomeLength;
+		const size_t fitnessesSize = sizeof(Fitness) * population;
+		m_payload.resize(individualsSize + fitnessesSize);
+		memcpy(m_payload.data(), ga.getIndividuals(), individualsSize);
+		memcpy(m_payload.data() + individualsSize, ga.getFitnesses(), fitnessesSize);
+	}
+	else
+	{
+		encodeDelta(ga);
+	}
+	record.payloadSize = m_payload.size();
+	record.checksum = ModelFile::checksum(m_payload.data(), m_payload.size(), ModelFile::checksum(&record, sizeof(record)));
+
+	const uint64_t offset = m_end;
+	m_ofs.write(reinterpret_cast<const char*>(&record), sizeof(record));
+	m_ofs.write(m_payload.data(), m_payload.size());
+	if (!m_ofs.flush())
+		return false;
+	m_end += sizeof(record) + record.payloadSize;
+
+	// ̍̊Ƃč̏Ԃc
+	reserve(population, chromosomeLength);
+	memcpy(m_individuals.get(), ga.getIndividuals(), sizeof(Gene) * population * chromosomeLength);
+	memcpy(m_fitnesses.get(), ga.getFitnesses(), sizeof(Fitness) * population);
+	m_sinceSnapshot = snapshot ? 0 : m_sinceSnapshot + 1;
+	m_entries.push_back({ record.generation, population, chromosomeLength, record.type, offset });
+	return true;
+}
+
+template<typename Gene, typename Fitness>
+inline bool GeneticAlgorithmLog<Gene, Fitness>::restore(int generation, GeneticAlgorithm<Gene, Fitness>& ga)
+{
+	int index = static_cast<int>(m_entries.size()) - 1;
+	while (index >= 0 && m_entries[index].generation != generation)
+		--index;
+	if (index < 0)
+		return false;
+
+	// OSNAPSHOT珇ɍ𓖂ĂĂ
+	int first = index;
+	while (m_entries[first].type != GeneticAlgorithmLogRecord::SNAPSHOT)
+		--first;
+
+	GeneticAlgorithmLogRecord record = {};
+	std::unique_ptr<Gene[]> individuals(new Gene[m_entries[index].population * m_entries[index].chromosomeLength]);
+	std::unique_ptr<Fitness[]> fitnesses(new Fitness[m_entries[index].population]);
+	for (int i = first; i <= index; ++i)
+	{
+		if (!read(i, record, individuals.get(), fitnesses.get()))
+			return false;
+	}
+
+	ga.reset(record.population, record.chromosomeLength, static_cast<Gene>(record.chromosomeValueMin), static_cast<Gene>(record.chromosomeValueMax), record.eliteNum, record.generation);
+	ga.setIndividuals(individuals.get());
+	ga.evaluate(fitnesses.get());
+	ga.setSelection(static_cast<SelectionID>(record.selection), record.tournamentSize);
+	ga.setSeed(record.seed);
+	ga.setRandomState(record.random);
+	return true;
+}
+
+template<typename Gene, typename Fitness>
+inline int GeneticAlgorithmLog<Gene, Fitness>::getRecordNum() const
+{
+	return static_cast<int>(m_entries.size());
+}
+
+template<typename Gene, typename Fitness>
+inline int GeneticAlgorithmLog<Gene, Fitness>::getRecordGeneration(int index) const
+{
+	return m_entries[index].generation;
+}
+
+template<typename Gene, typename Fitness>
+inline bool GeneticAlgorithmLog<Gene, Fitness>::scan()
+{
+	GeneticAlgorithmLogHeader header = {};
+	if (!m_ifs.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		return false;
+	if (header.magic != GeneticAlgorithmLogHeader::MAGIC || header.version != GeneticAlgorithmLogHeader::VERSION)
+		return false;
+	if (header.geneType != ModelFile::weightType<Gene>() || header.fitnessType != ModelFile::weightType<Fitness>())
+		return false;
+
+	// R[ḧʒuW߂ (yC[h͓ǂݔ΂)
+	const uint64_t fileSize = std::filesystem::file_size(m_path);
+	m_end = fileSize; // ؂̂Ă܂ł́Aread֐t@C̑傫Ɣׂ
+	uint64_t offset = sizeof(header);
+	while (offset + sizeof(GeneticAlgorithmLogRecord) <= fileSize)
+	{
+		GeneticAlgorithmLogRecord record = {};
+		m_ifs.seekg(offset);
+		if (!m_ifs.read(reinterpret_cast<char*>(&record), sizeof(record)))
+			break;
+		// payloadSize̓t@C̒lȂ̂ŁAZȂ悤ZŔׂ
+		if (record.magic != GeneticAlgorithmLogRecord::MAGIC || record.payloadSize > fileSize - offset - sizeof(record))
+			break;
+		if (m_entries.empty() && record.type != GeneticAlgorithmLogRecord::SNAPSHOT)
+			break;
+		m_entries.push_back({ record.generation, record.population, record.chromosomeLength, record.type, offset });
+		offset += sizeof(record) + record.payloadSize;
+	}
+	m_ifs.clear();
+
+	// Ō̃R[hǂŎ̍̊Ƃ (Ă΂POɖ߂)
+	while (!m_entries.empty())
+	{
+		const Entry& last = m_entries.back();
+		GeneticAlgorithmLogRecord record = {};
+		if (read(static_cast<int>(m_entries.size()) - 1, record, nullptr, nullptr))
+		{
+			int first = static_cast<int>(m_entries.size()) - 1;
+			while (m_entries[first].type != GeneticAlgorithmLogRecord::SNAPSHOT)
+				--first;
+			reserve(record.population, record.chromosomeLength);
+			bool valid = true;
+			for (int i = first; i < static_cast<int>(m_entries.size()) && valid; ++i)
+				valid = read(i, record, m_individuals.get(), m_fitnesses.get());
+			if (valid)
+			{
+				m_sinceSnapshot = static_cast<int>(m_entries.size()) - 1 - first;
+				break;
+			}
+		}
+		offset = last.offset;
+		m_entries.pop_back();
+	}
+
+	// ݓrŎ~܂؂̂Ă
+	m_end = offset;
+	if (offset < fileSize)
+	{
+		m_ifs.close();
+		std::error_code error;
+		std::filesystem::resize_file(m_path, offset, error);
+		if (error)
+			return false;
+		m_ifs.open(m_path, std::ios::in | std::ios::binary);
+	}
+	return static_cast<bool>(m_ifs);
+}
+
+template<typename Gene, typename Fitness>
+inline bool GeneticAlgorithmLog<Gene, Fitness>::read(int index, GeneticAlgorithmLogRecord& record, Gene* individuals, Fitness* fitnesses)
+{
+	m_ifs.clear();
+	m_ifs.seekg(m_entries[index].offset);
+	if (!m_ifs.read(reinterpret_cast<char*>(&record), sizeof(record)))
+		return false;
+
+	// t@CɎ܂Ȃ傫͊mۂOɒe
+	const uint64_t offset = m_entries[index].offset;
+	if (offset + sizeof(record) > m_end || record.payloadSize > m_end - offset - sizeof(record))
+		return false;
+	m_payload.resize(record.payloadSize);
+	if (!m_ifs.read(m_payload.data(), record.payloadSize))
+		return false;
+
+	GeneticAlgorithmLogRecord zero = record;
+	zero.checksum = 0;
+	if (ModelFile::checksum(m_payload.data(), m_payload.size(), ModelFile::checksum(&zero, sizeof(zero))) != record.checksum)
+		return false;
+	if (individuals == nullptr)
+		return true;
+
+	// ̂̓eo (DELTAindividualsfitnessesɒÕR[h̓eĂ邱)
+	const int population = record.population;
+	const int chromosomeLength = record.chromosomeLength;
+	if (record.type == GeneticAlgorithmLogRecord::SNAPSHOT)
+	{
+		const size_t individualsSize = sizeof(Gene) * population * chromosomeLength;
+		if (m_payload.size() != individualsSize + sizeof(Fitness) * population)
+			return false;
+		memcpy(individuals, m_payload.data(), individualsSize);
+		memcpy(fitnesses, m_payload.data() + individualsSize, sizeof(Fitness) * population);
+		return true;
+	}
+	return decodeDelta(m_payload.data(), m_payload.data() + m_payload.size(), population, chromosomeLength, individuals, fitnesses);
+}
+
+template<typename Gene, typename Fitness>
+inline void GeneticAlgorithmLog<Gene, Fitness>::encodeDelta(const GeneticAlgorithm<Gene, Fitness>& ga)
+{
+	const int population = ga.getPopulation();
+	const int chromosomeLength = ga.getChromosomeLength();
+	const size_t chromosomeSize = sizeof(Gene) * chromosomeLength;
+
+	// ÕR[h̐F̂eň悤ɂ
+	m_chromosomeIndex.clear();
+	for (int i = population - 1; i >= 0; --i)
+		m_chromosomeIndex[ModelFile::checksum(&m_individuals[i * chromosomeLength], chromosomeSize)] = i;
+
+	for (int i = 0; i < population; ++i)
+	{
+		const Gene* chromosome = ga.getIndividual(i);
+		auto found = m_chromosomeIndex.find(ModelFile::checksum(chromosome, chromosomeSize));
+		if (found != m_chromosomeIndex.end() && memcmp(&m_individuals[found->second * chromosomeLength], chromosome, chromosomeSize) == 0)
+		{
+			writeVarint(m_payload, static_cast<uint64_t>(found->second) + 2);
+			continue;
+		}
+
+		const size_t begin = m_payload.size();
+		writeVarint(m_payload, 0);
+		const Gene* base = &m_individuals[i * chromosomeLength];
+		for (int j = 0; j < chromosomeLength; ++j)
+			encodeValue(m_payload, chromosome[j], base[j]);
+
+		// ŏk܂Ȃ΂̂܂܏
+		if (m_payload.size() - begin > chromosomeSize + 1)
+		{
+			m_payload.resize(begin);
+			writeVarint(m_payload, 1);
+			const char* data = reinterpret_cast<const char*>(chromosome);
+			m_payload.insert(m_payload.end(), data, data + chromosomeSize);
+		}
+	}
+
+	const Fitness* fitnesses = ga.getFitnesses();
+	for (int i = 0; i < population; ++i)
+		encodeValue(m_payload, fitnesses[i], m_fitnesses[i]);
+}
+
+template<typename Gene, typename Fitness>
+inline bool GeneticAlgorithmLog<Gene, Fitness>::decodeDelta(const char* data, const char* end, int population, int chromosomeLength, Gene* individuals, Fitness* fitnesses)
+{
+	// QƐ悪㏑Ȃ悤AÕR[h̓ecĂ
+	m_base.assign(individuals, individuals + population * chromosomeLength);
+
+	for (int i = 0; i < population; ++i)
+	{
+		uint64_t reference = 0;
+		if (!readVarint(data, end, reference) || reference > static_cast<uint64_t>(population) + 1)
+			return false;
+		Gene* chromosome = &individuals[i * chromosomeLength];
+		if (reference >= 2)
+		{
+			memcpy(chromosome, &m_base[(reference - 2) * chromosomeLength], sizeof(Gene) * chromosomeLength);
+			continue;
+		}
+		if (reference == 1)
+		{
+			if (static_cast<size_t>(end - data) < sizeof(Gene) * chromosomeLength)
+				return false;
+			memcpy(chromosome, data, sizeof(Gene) * chromosomeLength);
+			data += sizeof(Gene) * chromosomeLength;
+			continue;
+		}
+		for (int j = 0; j < chromosomeLength; ++j)
+		{
+			if (!decodeValue(data, end, chromosome[j]))
+				return false;
+		}
+	}
+	for (int i = 0; i < population; ++i)
+	{
+		if (!decodeValue(data, end, fitnesses[i]))
+			return false;
+	}
+	return data == end;
+}
+
+template<typename Gene, typename Fitness>
+inline void GeneticAlgorithmLog<Gene, Fitness>::reserve(int population, int chromosomeLength)
+{
+	if (population == m_population && chromosomeLength == m_chromosomeLength)
+		return;
+	m_population = population;
+	m_chromosomeLength = chromosomeLength;
+	m_individuals.reset(new Gene[population * chromosomeLength]);
+	m_fitnesses.reset(new Fitness[population]);
+}
+
+template<typename Gene, typename Fitness>
+template<typename T>
+inline void GeneticAlgorithmLog<Gene, Fitness>::encodeValue(std::vector<char>& out, T value, T base)
+{
+	if constexpr (std::is_integral_v<T>)
+	{
+		// WOUOďȐΒlZ
+		int64_t diff = static_cast<int64_t>(value) - base;
+		writeVarint(out, (static_cast<uint64_t>(diff) << 1) ^ static_cast<uint64_t>(diff >> 63));
+	}
+	else
+	{
+		// ƎwȂʂ̃oCg0ɂȂ
+		using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+		Bits bits = 0;
+		Bits baseBits = 0;
+		memcpy(&bits, &value, sizeof(bits));
+		memcpy(&baseBits, &base, sizeof(baseBits));
+		uint64_t x = bits ^ baseBits;
+		char n = 0;
+		while (n < static_cast<char>(sizeof(Bits)) && (x >> (n * 8)) != 0)
+			++n;
+		out.push_back(n);
+		for (int i = 0; i < n; ++i)
+			out.push_back(static_cast<char>(x >> (i * 8)));
+	}
+}
+
+template<typename Gene, typename Fitness>
+template<typename T>
+inline bool GeneticAlgorithmLog<Gene, Fitness>::decodeValue(const char*& data, const char* end, T& value)
+{
+	if constexpr (std::is_integral_v<T>)
+	{
+		uint64_t zigzag = 0;
+		if (!readVarint(data, end, zigzag))
+			return false;
+		int64_t diff = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+		value = static_cast<T>(value + diff);
+		return true;
+	}
+	else
+	{
+		if (data == end)
+			return false;
+		using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+		int n = static_cast<unsigned char>(*data++);
+		if (n > static_cast<int>(sizeof(Bits)) || end - data < n)
+			return false;
+		uint64_t x = 0;
+		for (int i = 0; i < n; ++i)
+			x |= static_cast<uint64_t>(static_cast<unsigned char>(*data++)) << (i * 8);
+		Bits bits = 0;
+		memcpy(&bits, &value, sizeof(bits));
+		bits ^= static_cast<Bits>(x);
+		memcpy(&value, &bits, sizeof(bits));
+		return true;
+	}
+}
+
+template<typename Gene, typename Fitness>
+inline void GeneticAlgorithmLog<Gene, Fitness>::writeVarint(std::vector<char>& out, uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		out.push_back(static_cast<char>(value | 0x80));
+		value >>= 7;
+	}
+	out.push_back(static_cast<char>(value));
+}
+
+template<typename Gene, typename Fitness>
+inline bool GeneticAlgorithmLog<Gene, Fitness>::readVarint(const char*& data, const char* end, uint64_t& value)
+{
+	value = 0;
+	for (int shift = 0; shift < 64 && data != end; shift += 7)
+	{
+		unsigned char byte = static_cast<unsigned char>(*data++);
+		value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0)
+			return true;
+	}
+	return false;
+}
@@ -8,10 +8,41 @@ class Identity : public ActivationFunction<T>
 public:
 	T operator()(T x) const override
 	{
-		return x;
+		return compute(x);
 	}
 	explicit operator ActFncID() const noexcept override
 	{
 		return ActFncID::IDENTITY;
 	}
+
+	// z֐ȂvZ
+	static T compute(T x)
+	{
+		return x;
+	}
+
+	/*
+	* z̑SvfɓKp
+	* 
+	* @param x z (㏑)
+	* @param n vf
+	*/
+	static void apply(T*, int)
+	{
+		// P֐Ȃ̂ŉȂ
+	}
+
+	/*
+	* z̑SvfɂĔl߂
+	* 
+	* @param x ֐KpO̒l̔z
+	* @param y ֐Kp̒l̔z
+	* @param d l̏ݐ
+	* @param n vf
+	*/
+	static void derivative(const T*, const T*, T* d, int n)
+	{
+		for (int i = 0; i < n; ++i)
+			d[i] = 1;
+	}
 };
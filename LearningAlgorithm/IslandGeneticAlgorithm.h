@@ -0,0 +1,324 @@
+#pragma once
+
+#include "GeneticAlgorithm.h"
+#include <memory>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include <cstring>
+
+enum class MigrationTopology
+{
+	RING,
+	FULLY_CONNECTED
+};
+
+/*
+* template<typename Gene, typename Fitness>
+* Gene    F̂̌^ intEfloatEdouble
+* Fitness Kx̌^ intEfloatEdouble
+* 
+* GeneticAlgorithm () ꂼʂ̃XbhŐi铇f
+* 
+* 萢ゲƂɊe̗DGȌ (ږ) ׂ֑̓
+* ږ̎󂯓n͓̑gƂ̃bNt[ȃOobt@ōs
+* 󂯎葤̋󂫂Ȃ΂̈ږ͎̂Ă (葤͑҂Ȃ)
+* 
+* ̃NX̐͂܂reset֐s邱
+* Ȃꍇ̑̊֐ĂяoȂ
+*/
+template<typename Gene, typename Fitness>
+class IslandGeneticAlgorithm
+{
+public:
+	/*
+	* KxvZ֐
+	* 
+	* Ƃ̃Xbh瓯ɌĂ΂
+	* 
+	* @param island    ̃CfbNX
+	* @param ga        ̓GeneticAlgorithm
+	* @param fitnesses Kx̏ݐ TCY = Ƃ̐l
+	*/
+	using EvaluateFunction = std::function<void(int island, const GeneticAlgorithm<Gene, Fitness>& ga, Fitness* fitnesses)>;
+
+public:
+	IslandGeneticAlgorithm();
+	~IslandGeneticAlgorithm();
+
+	IslandGeneticAlgorithm(const IslandGeneticAlgorithm&) = delete;
+	IslandGeneticAlgorithm& operator=(const IslandGeneticAlgorithm&) = delete;
+
+	IslandGeneticAlgorithm(IslandGeneticAlgorithm&&) = default;
+	IslandGeneticAlgorithm& operator=(IslandGeneticAlgorithm&&) = default;
+
+public:
+	/*
+	* ̐Ɗẽp[^ɉĕKvȃmۂ
+	* 
+	* @param islandNum          ̐
+	* @param population         Ƃ̐l
+	* @param chromosomeLength   P̓̐F̂̒
+	* @param chromosomeValueMin F̂̓eƂĎ蓾ŏl (܂)
+	* @param chromosomeValueMax F̂̓eƂĎ蓾ől (܂)
+	* @param eliteNum           ƂɎɎzG[g̐
+	*/
+	void reset(int islandNum, int population, int chromosomeLength, Gene chromosomeValueMin, Gene chromosomeValueMax, int eliteNum);
+
+	/*
+	* ̃V[h̐ݒ
+	* 
+	* eɂ͂̃V[h瓱ʁX̃V[hݒ肳
+	* 
+	* @param seed V[h
+	*/
+	void setSeed(uint64_t seed);
+
+	/*
+	* ڏZ̐ݒ
+	* 
+	* @param topology   ږ𑗂 (RING = ̓̂݁AFULLY_CONNECTED = ̑SĂ̓)
+	* @param interval   ڏZs̊Ԋu (0 = ڏZȂ)
+	* @param migrantNum P̈ڏZő悲Ƃɑ̐
+	*/
+	void setMigration(MigrationTopology topology, int interval, int migrantNum);
+
+	/*
+	* SĂ̓̑S̂̐F̂̓e_ɐݒ肷
+	* 
+	* @param min _̍ŏl (܂)
+	* @param max _̍ől (܂)
+	*/
+	void setIndividualsRandom(Gene min, Gene max);
+
+	/*
+	* SĂ̓generationNumi
+	* 
+	* ƂɁuKx̌vZ  (ڏZ̐Ȃږ𑗂)  ̐  ͂ږ̎󂯓vJԂ
+	* ږ͎̃G[gȊǑ̂̂ACfbNX̑傫㏑
+	* 
+	* @param generationNum i߂鐢㐔
+	* @param evaluate      KxvZ֐
+	*/
+	void run(int generationNum, const EvaluateFunction& evaluate);
+
+	// @return ̐
+	int getIslandNum() const;
+
+	// @return indexԖ(0-based)̓
+	GeneticAlgorithm<Gene, Fitness>& getIsland(int index);
+
+	// @return indexԖ(0-based)̓
+	const GeneticAlgorithm<Gene, Fitness>& getIsland(int index) const;
+
+private:
+	// ږ󂯓nPꐶYҁEP҂̃bNt[ȃOobt@
+	class MigrationQueue
+	{
+	public:
+		MigrationQueue(int capacity, int chromosomeLength)
+			: m_capacity(capacity)
+			, m_chromosomeLength(chromosomeLength)
+			, m_buffer(new Gene[capacity * chromosomeLength])
+			, m_head(0)
+			, m_tail(0)
+		{
+		}
+
+		// @return 󂫂ȂȂꍇfalse
+		bool push(const Gene* chromosome)
+		{
+			uint32_t tail = m_tail.load(std::memory_order_relaxed);
+			if (tail - m_head.load(std::memory_order_acquire) == static_cast<uint32_t>(m_capacity))
+				return false;
+			memcpy(&m_buffer[(tail % m_capacity) * m_chromosomeLength], chromosome, sizeof(Gene) * m_chromosomeLength);
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		// @return ͂ĂږȂꍇfalse
+		bool pop(Gene* chromosome)
+		{
+			uint32_t head = m_head.load(std::memory_order_relaxed);
+			if (head == m_tail.load(std::memory_order_acquire))
+				return false;
+			memcpy(chromosome, &m_buffer[(head % m_capacity) * m_chromosomeLength], sizeof(Gene) * m_chromosomeLength);
+			m_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+	private:
+		const int m_capacity;
+		const int m_chromosomeLength;
+		std::unique_ptr<Gene[]> m_buffer;
+		std::atomic<uint32_t> m_head;
+		std::atomic<uint32_t> m_tail;
+	};
+
+	void buildQueues();
+	void runIsland(int island, int generationNum, const EvaluateFunction& evaluate);
+
+private:
+	int m_islandNum;
+	std::unique_ptr<GeneticAlgorithm<Gene, Fitness>[]> m_islands;
+	MigrationTopology m_topology;
+	int m_interval;
+	int m_migrantNum;
+	std::vector<std::unique_ptr<MigrationQueue>> m_queues;
+};
+
+
+
+
+template<typename Gene, typename Fitness>
+inline IslandGeneticAlgorithm<Gene, Fitness>::IslandGeneticAlgorithm()
+	: m_islandNum()
+	, m_islands()
+	, m_topology(MigrationTopology::RING)
+	, m_interval()
+	, m_migrantNum()
+	, m_queues()
+{
+}
+
+template<typename Gene, typename Fitness>
+inline IslandGeneticAlgorithm<Gene, Fitness>::~IslandGeneticAlgorithm()
+{
+}
+
+template<typename Gene, typename Fitness>
+inline void IslandGeneticAlgorithm<Gene, Fitness>::reset(int islandNum, int population, int chromosomeLength, Gene chromosomeValueMin, Gene chromosomeValueMax, int eliteNum)
+{
+	m_islandNum = islandNum;
+	m_islands.reset(new GeneticAlgorithm<Gene, Fitness>[islandNum]);
+	for (int i = 0; i < islandNum; ++i)
+		m_islands[i].reset(population, chromosomeLength, chromosomeValueMin, chromosomeValueMax, eliteNum);
+	buildQueues();
+}
+
+template<typename Gene, typename Fitness>
+inline void IslandGeneticAlgorithm<Gene, Fitness>::setSeed(uint64_t seed)
+{
+	for (int i = 0; i < m_islandNum; ++i)
+		m_islands[i].setSeed(Random(seed, i)());
+}
+
+template<typename Gene, typename Fitness>
+inline void IslandGeneticAlgorithm<Gene, Fitness>::setMigration(MigrationTopology topology, int interval, int migrantNum)
+{
+	m_topology = topology;
+	m_interval = interval;
+	m_migrantNum = migrantNum;
+	buildQueues();
+}
+
+template<typename Gene, typename Fitness>
+inline void IslandGeneticAlgorithm<Gene, Fitness>::setIndividualsRandom(Gene min, Gene max)
+{
+	for (int i = 0; i < m_islandNum; ++i)
+		m_islands[i].setIndividualsRandom(min, max);
+}
+
+template<typename Gene, typename Fitness>
+inline void IslandGeneticAlgorithm<Gene, Fitness>::run(int generationNum, const EvaluateFunction& evaluate)
+{
+	std::vector<std::thread> threads;
+	threads.reserve(m_islandNum);
+	for (int i = 0; i < m_islandNum; ++i)
+		threads.emplace_back(&IslandGeneticAlgorithm::runIsland, this, i, generationNum, std::cref(evaluate));
+	for (auto& thread : threads)
+		thread.join();
+}
+
+template<typename Gene, typename Fitness>
+inline int IslandGeneticAlgorithm<Gene, Fitness>::getIslandNum() const
+{
+	return m_islandNum;
+}
+
+template<typename Gene, typename Fitness>
+inline GeneticAlgorithm<Gene, Fitness>& IslandGeneticAlgorithm<Gene, Fitness>::getIsland(int index)
+{
+	return m_islands[index];
+}
+
+template<typename Gene, typename Fitness>
+inline const GeneticAlgorithm<Gene, Fitness>& IslandGeneticAlgorithm<Gene, Fitness>::getIsland(int index) const
+{
+	return m_islands[index];
+}
+
+template<typename Gene, typename Fitness>
+inline void IslandGeneticAlgorithm<Gene, Fitness>::buildQueues()
+{
+	// ږ𑗂铇̑g (茳 * ̐ + ) ƂɃobt@
+	m_queues.clear();
+	m_queues.resize(m_islandNum * m_islandNum);
+	if (m_islandNum < 2 || m_interval <= 0 || m_migrantNum <= 0)
+		return;
+
+	// 󂯎葤Q񕪂̈ڏZ𗭂߂邾̗e
+	const int capacity = m_migrantNum * 2;
+	const int chromosomeLength = m_islands[0].getChromosomeLength();
+	for (int from = 0; from < m_islandNum; ++from)
+	{
+		for (int to = 0; to < m_islandNum; ++to)
+		{
+			bool connected = m_topology == MigrationTopology::RING ? to == (from + 1) % m_islandNum : to != from;
+			if (connected)
+				m_queues[from * m_islandNum + to].reset(new MigrationQueue(capacity, chromosomeLength));
+		}
+	}
+}
+
+template<typename Gene, typename Fitness>
+inline void IslandGeneticAlgorithm<Gene, Fitness>::runIsland(int island, int generationNum, const EvaluateFunction& evaluate)
+{
+	auto& ga = m_islands[island];
+	const int population = ga.getPopulation();
+	const int chromosomeLength = ga.getChromosomeLength();
+	const int migrantNum = std::min(m_migrantNum, population);
+	std::unique_ptr<Fitness[]> fitnesses(new Fitness[population]);
+	std::unique_ptr<int[]> order(new int[population]);
+	std::unique_ptr<Gene[]> immigrant(new Gene[chromosomeLength]);
+
+	for (int g = 0; g < generationNum; ++g)
+	{
+		evaluate(island, ga, fitnesses.get());
+		ga.evaluate(fitnesses.get());
+
+		// Kx̍̂ږƂđ (󂫂ȂΎ̂Ă)
+		bool migration = m_interval > 0 && (g + 1) % m_interval == 0;
+		if (migration && migrantNum > 0)
+		{
+			for (int i = 0; i < population; ++i)
+				order[i] = i;
+			std::partial_sort(order.get(), order.get() + migrantNum, order.get() + population, [&fitnesses](int lhs, int rhs)
+				{ return fitnesses[lhs] > fitnesses[rhs]; }
+			);
+			for (int to = 0; to < m_islandNum; ++to)
+			{
+				auto& queue = m_queues[island * m_islandNum + to];
+				if (!queue)
+					continue;
+				for (int i = 0; i < migrantNum; ++i)
+					queue->push(ga.getIndividual(order[i]));
+			}
+		}
+
+		ga.generateNextGeneration();
+
+		// ͂ĂږG[gȊǑ̂Ɠւ
+		int replace = population - 1;
+		for (int from = 0; from < m_islandNum; ++from)
+		{
+			auto& queue = m_queues[from * m_islandNum + island];
+			if (!queue)
+				continue;
+			while (replace >= ga.getEliteNum() && queue->pop(immigrant.get()))
+				ga.setIndividual(replace--, immigrant.get());
+		}
+	}
+}
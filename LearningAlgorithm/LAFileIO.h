@@ -3,25 +3,117 @@
 #include "NeuralNetwork.h"
 #include "GeneticAlgorithm.h"
 #include "ActivationFunction.h"
+#include "ModelFile.h"
+#include "SparseNeuralNetwork.h"
+#include "FixedNeuralNetwork.h"
 #include <string>
 #include <fstream>
 #include <memory>
+#include <vector>
 
 class LAFileIO
 {
 public:
+	/*
+	* NeuralNetworkǂݍ
+	* 
+	* ֐ (ID | x << 16) 4oCgŋL^
+	* xL^ĂȂÂt@C͏16bit0Ȃ̂ŁAxEXACTɂȂ
+	*/
 	template<typename T>
 	static bool inputNeuralNetwork(std::string path, NeuralNetwork<T>& nn);
 
 	template<typename T>
 	static bool outputNeuralNetwork(std::string path, const NeuralNetwork<T>& nn);
 
+	// outputNeuralNetwork֐ƓeXg[ɏo
+	template<typename T>
+	static bool outputNeuralNetwork(std::ostream& os, const NeuralNetwork<T>& nn);
+
+	/*
+	* FixedNeuralNetworkNeuralNetworkƓ`œǂݍ
+	* 
+	* @return ǂݍ߂Ȃꍇw̑傫E֐ExvȂꍇfalse
+	*/
+	template<typename T, int InputSize, typename... Layers>
+	static bool inputNeuralNetwork(std::string path, FixedNeuralNetwork<T, InputSize, Layers...>& nn);
+
+	// FixedNeuralNetworkNeuralNetworkƓ`ŏo
+	template<typename T, int InputSize, typename... Layers>
+	static bool outputNeuralNetwork(std::string path, const FixedNeuralNetwork<T, InputSize, Layers...>& nn);
+
+	// outputNeuralNetwork֐ƓeXg[ɏo
+	template<typename T, int InputSize, typename... Layers>
+	static bool outputNeuralNetwork(std::ostream& os, const FixedNeuralNetwork<T, InputSize, Layers...>& nn);
+
+	/*
+	* ft@C (ModelFile.h) NeuralNetworkǂݍ
+	* 
+	* d݂nnmۂɃRs[
+	* Rs[ɎgꍇMappedModelNXg
+	* 
+	* @param verify truȅꍇchecksum؂
+	* @return ǂݍ߂Ȃꍇsȃt@C̏ꍇfalse
+	*/
+	template<typename T>
+	static bool inputNeuralNetworkModel(std::string path, NeuralNetwork<T>& nn, bool verify = true);
+
+	/*
+	* NeuralNetworkft@C (ModelFile.h) ̌`ŏo
+	* 
+	* @return oȂꍇfalse
+	*/
+	template<typename T>
+	static bool outputNeuralNetworkModel(std::string path, const NeuralNetwork<T>& nn);
+
+	// outputNeuralNetworkModel֐ƓeXg[ɏo
+	template<typename T>
+	static bool outputNeuralNetworkModel(std::ostream& os, const NeuralNetwork<T>& nn);
+
+	/*
+	* SparseNeuralNetworkǂݍ
+	* 
+	* `, ͑w̃m[h, w̐, wƂ (m[h, ֐, vf, rowBegin, index, value, bias)
+	* 
+	* @return ǂݍ߂Ȃꍇw̑傫EYEt@C̑傫Ăꍇfalse
+	*/
+	template<typename T>
+	static bool inputSparseNeuralNetwork(std::string path, SparseNeuralNetwork<T>& snn);
+
+	template<typename T>
+	static bool outputSparseNeuralNetwork(std::string path, const SparseNeuralNetwork<T>& snn);
+
+	// outputSparseNeuralNetwork֐ƓeXg[ɏo
+	template<typename T>
+	static bool outputSparseNeuralNetwork(std::ostream& os, const SparseNeuralNetwork<T>& snn);
+
 	template<typename Gene, typename Fitness>
 	static bool inputGeneticAlgorithm(std::string path, GeneticAlgorithm<Gene, Fitness>& ga);
 
 	template<typename Gene, typename Fitness>
 	static bool outputGeneticAlgorithm(std::string path, const GeneticAlgorithm<Gene, Fitness>& ga);
 
+	// outputGeneticAlgorithm֐ƓeXg[ɏo
+	template<typename Gene, typename Fitness>
+	static bool outputGeneticAlgorithm(std::ostream& os, const GeneticAlgorithm<Gene, Fitness>& ga);
+
+private:
+	// @return ֐IDƐx4oCgɂ܂Ƃ߂l
+	static int32_t encodeActFnc(ActFncID id, ActFncPrecision precision)
+	{
+		return static_cast<int32_t>(id) | (static_cast<int32_t>(precision) << 16);
+	}
+
+	static ActFncID decodeActFncID(int32_t actFnc)
+	{
+		return ActFncID(actFnc & 0xffff);
+	}
+
+	static ActFncPrecision decodeActFncPrecision(int32_t actFnc)
+	{
+		return ActFncPrecision(actFnc >> 16);
+	}
+
 private:
 	LAFileIO() = delete;
 };
@@ -45,20 +137,20 @@ bool LAFileIO::inputNeuralNetwork(std::string path, NeuralNetwork<T>& nn)
 	ifs.read(reinterpret_cast<char*>(&hiddenLayerNum), sizeof(hiddenLayerNum));
 
 	std::unique_ptr<int[]> hiddenLayerSize(new int[hiddenLayerNum]);
-	std::unique_ptr<ActFncID[]> hiddenLayerActFncID(new ActFncID[hiddenLayerNum]);
+	std::unique_ptr<int32_t[]> hiddenLayerActFnc(new int32_t[hiddenLayerNum]);
 	ifs.read(reinterpret_cast<char*>(hiddenLayerSize.get()), sizeof(hiddenLayerSize[0]) * hiddenLayerNum);
-	ifs.read(reinterpret_cast<char*>(hiddenLayerActFncID.get()), sizeof(hiddenLayerActFncID[0]) * hiddenLayerNum);
+	ifs.read(reinterpret_cast<char*>(hiddenLayerActFnc.get()), sizeof(hiddenLayerActFnc[0]) * hiddenLayerNum);
 
 	int outputLayerSize = 0;
-	ActFncID outputLayerActFncID = ActFncID::IDENTITY;
+	int32_t outputLayerActFnc = 0;
 	ifs.read(reinterpret_cast<char*>(&outputLayerSize), sizeof(outputLayerSize));
-	ifs.read(reinterpret_cast<char*>(&outputLayerActFncID), sizeof(outputLayerActFncID));
+	ifs.read(reinterpret_cast<char*>(&outputLayerActFnc), sizeof(outputLayerActFnc));
 
 	nn.setInputLayer(inputLayerSize);
 	nn.setHiddenLayerNum(hiddenLayerNum);
 	for (int i = 0; i < hiddenLayerNum; ++i)
-		nn.setHiddenLayer(hiddenLayerSize[i], hiddenLayerActFncID[i]);
-	nn.setOutputLayer(outputLayerSize, outputLayerActFncID);
+		nn.setHiddenLayer(hiddenLayerSize[i], decodeActFncID(hiddenLayerActFnc[i]), decodeActFncPrecision(hiddenLayerActFnc[i]));
+	nn.setOutputLayer(outputLayerSize, decodeActFncID(outputLayerActFnc), decodeActFncPrecision(outputLayerActFnc));
 
 	ifs.read(const_cast<char*>(reinterpret_cast<const char*>(nn.getWeight())), sizeof(nn.getWeight()[0]) * nn.getWeightSize());
 
@@ -72,29 +164,218 @@ bool LAFileIO::outputNeuralNetwork(std::string path, const NeuralNetwork<T>& nn)
 	if (!ofs)
 		return false;
 
+	return outputNeuralNetwork(ofs, nn);
+}
+
+template<typename T>
+bool LAFileIO::outputNeuralNetwork(std::ostream& ofs, const NeuralNetwork<T>& nn)
+{
 	int inputLayerSize = nn.getInputLayerSize();
 	int hiddenLayerNum = nn.getHiddenLayerNum();
 	std::unique_ptr<int[]> hiddenLayerSize(new int[hiddenLayerNum]);
-	std::unique_ptr<ActFncID[]> hiddenLayerActFncID(new ActFncID[hiddenLayerNum]);
+	std::unique_ptr<int32_t[]> hiddenLayerActFnc(new int32_t[hiddenLayerNum]);
 	for (int i = 0; i < hiddenLayerNum; ++i)
 	{
 		hiddenLayerSize[i] = nn.getHiddenLayerSize(i);
-		hiddenLayerActFncID[i] = nn.getHiddenLayerActFncID(i);
+		hiddenLayerActFnc[i] = encodeActFnc(nn.getHiddenLayerActFncID(i), nn.getHiddenLayerActFncPrecision(i));
 	}
 	int outputLayerSize = nn.getOutputLayerSize();
-	ActFncID outputLayerActFncID = nn.getOutputLayerActFncID();
+	int32_t outputLayerActFnc = encodeActFnc(nn.getOutputLayerActFncID(), nn.getOutputLayerActFncPrecision());
 
 	ofs.write(reinterpret_cast<const char*>(&inputLayerSize), sizeof(inputLayerSize));
 	ofs.write(reinterpret_cast<const char*>(&hiddenLayerNum), sizeof(hiddenLayerNum));
 	ofs.write(reinterpret_cast<const char*>(hiddenLayerSize.get()), sizeof(hiddenLayerSize[0]) * hiddenLayerNum);
-	ofs.write(reinterpret_cast<const char*>(hiddenLayerActFncID.get()), sizeof(hiddenLayerActFncID[0]) * hiddenLayerNum);
+	ofs.write(reinterpret_cast<const char*>(hiddenLayerActFnc.get()), sizeof(hiddenLayerActFnc[0]) * hiddenLayerNum);
 	ofs.write(reinterpret_cast<const char*>(&outputLayerSize), sizeof(outputLayerSize));
-	ofs.write(reinterpret_cast<const char*>(&outputLayerActFncID), sizeof(outputLayerActFncID));
+	ofs.write(reinterpret_cast<const char*>(&outputLayerActFnc), sizeof(outputLayerActFnc));
 	ofs.write(reinterpret_cast<const char*>(nn.getWeight()), sizeof(nn.getWeight()[0]) * nn.getWeightSize());
 
+	return static_cast<bool>(ofs);
+}
+
+template<typename T, int InputSize, typename... Layers>
+bool LAFileIO::inputNeuralNetwork(std::string path, FixedNeuralNetwork<T, InputSize, Layers...>& nn)
+{
+	NeuralNetwork<T> tmp;
+	if (!inputNeuralNetwork(path, tmp))
+		return false;
+
+	return nn.fromNeuralNetwork(tmp);
+}
+
+template<typename T, int InputSize, typename... Layers>
+bool LAFileIO::outputNeuralNetwork(std::string path, const FixedNeuralNetwork<T, InputSize, Layers...>& nn)
+{
+	std::ofstream ofs(path, std::ios::out | std::ios::binary);
+	if (!ofs)
+		return false;
+
+	return outputNeuralNetwork(ofs, nn);
+}
+
+template<typename T, int InputSize, typename... Layers>
+bool LAFileIO::outputNeuralNetwork(std::ostream& ofs, const FixedNeuralNetwork<T, InputSize, Layers...>& nn)
+{
+	NeuralNetwork<T> tmp;
+	nn.toNeuralNetwork(tmp);
+	return outputNeuralNetwork(ofs, tmp);
+}
+
+template<typename T>
+bool LAFileIO::inputNeuralNetworkModel(std::string path, NeuralNetwork<T>& nn, bool verify)
+{
+	std::ifstream ifs(path, std::ios::in | std::ios::binary | std::ios::ate);
+	if (!ifs)
+		return false;
+
+	std::streamoff size = ifs.tellg();
+	if (size <= 0)
+		return false;
+	std::unique_ptr<char[]> data(new char[size]);
+	ifs.seekg(0);
+	if (!ifs.read(data.get(), size))
+		return false;
+
+	NeuralNetwork<T> tmp;
+	const T* weight = ModelFile::parse(data.get(), static_cast<uint64_t>(size), verify, tmp);
+	if (weight == nullptr)
+		return false;
+	tmp.setWeight(weight);
+	nn = std::move(tmp);
+
 	return true;
 }
 
+template<typename T>
+bool LAFileIO::outputNeuralNetworkModel(std::string path, const NeuralNetwork<T>& nn)
+{
+	std::ofstream ofs(path, std::ios::out | std::ios::binary);
+	if (!ofs)
+		return false;
+
+	return outputNeuralNetworkModel(ofs, nn);
+}
+
+template<typename T>
+bool LAFileIO::outputNeuralNetworkModel(std::ostream& ofs, const NeuralNetwork<T>& nn)
+{
+	ModelHeader header;
+	std::unique_ptr<char[]> table;
+	ModelFile::layout(nn, header, table);
+
+	ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	ofs.write(table.get(), header.weightOffset - header.layerOffset);
+	ofs.write(reinterpret_cast<const char*>(nn.getWeight()), sizeof(nn.getWeight()[0]) * nn.getWeightSize());
+
+	return static_cast<bool>(ofs);
+}
+
+template<typename T>
+bool LAFileIO::inputSparseNeuralNetwork(std::string path, SparseNeuralNetwork<T>& snn)
+{
+	std::ifstream ifs(path, std::ios::in | std::ios::binary | std::ios::ate);
+	if (!ifs)
+		return false;
+
+	// w̑傫̓t@C̒lȂ̂ŁAmۂOɎc̃oCgƔׂ
+	const std::streamoff fileSize = ifs.tellg();
+	if (fileSize <= 0)
+		return false;
+	ifs.seekg(0);
+
+	int32_t format = 0;
+	int inputLayerSize = 0;
+	int layerNum = 0;
+	ifs.read(reinterpret_cast<char*>(&format), sizeof(format));
+	ifs.read(reinterpret_cast<char*>(&inputLayerSize), sizeof(inputLayerSize));
+	ifs.read(reinterpret_cast<char*>(&layerNum), sizeof(layerNum));
+	if (!ifs || layerNum <= 0 || inputLayerSize <= 0)
+		return false;
+
+	// ŏ̑w (m[h1Evf0) łc̃oCgɎ܂Ȃw̐́AmۂOɒe
+	const uint64_t minLayerBytes = sizeof(int32_t) * 3 + sizeof(int32_t) * 2 + sizeof(T);
+	if (static_cast<uint64_t>(layerNum) > static_cast<uint64_t>(fileSize - ifs.tellg()) / minLayerBytes)
+		return false;
+
+	const int64_t width = SparseFormat(format) == SparseFormat::BLOCK ? SparseNeuralNetwork<T>::BLOCK_SIZE : 1;
+	std::vector<SparseLayer<T>> layers(layerNum);
+	int srcSize = inputLayerSize;
+	for (SparseLayer<T>& layer : layers)
+	{
+		int32_t actFnc = 0;
+		int32_t elementNum = 0;
+		ifs.read(reinterpret_cast<char*>(&layer.size), sizeof(layer.size));
+		ifs.read(reinterpret_cast<char*>(&actFnc), sizeof(actFnc));
+		ifs.read(reinterpret_cast<char*>(&elementNum), sizeof(elementNum));
+		if (!ifs || layer.size <= 0 || elementNum < 0 || elementNum > static_cast<int64_t>(layer.size) * srcSize)
+			return false;
+
+		// el32bitȂ̂ŁA64bit̊|ZEZ͈Ȃ
+		const uint64_t layerBytes = sizeof(layer.rowBegin[0]) * (static_cast<uint64_t>(layer.size) + 1)
+			+ sizeof(layer.index[0]) * static_cast<uint64_t>(elementNum)
+			+ sizeof(layer.value[0]) * static_cast<uint64_t>(elementNum) * static_cast<uint64_t>(width)
+			+ sizeof(layer.bias[0]) * static_cast<uint64_t>(layer.size);
+		const std::streamoff position = ifs.tellg();
+		if (position < 0 || layerBytes > static_cast<uint64_t>(fileSize - position))
+			return false;
+
+		layer.srcSize = srcSize;
+		layer.actFncID = decodeActFncID(actFnc);
+		layer.precision = decodeActFncPrecision(actFnc);
+		layer.rowBegin.resize(layer.size + 1);
+		layer.index.resize(elementNum);
+		layer.value.resize(elementNum * width);
+		layer.bias.resize(layer.size);
+		ifs.read(reinterpret_cast<char*>(layer.rowBegin.data()), sizeof(layer.rowBegin[0]) * layer.rowBegin.size());
+		ifs.read(reinterpret_cast<char*>(layer.index.data()), sizeof(layer.index[0]) * layer.index.size());
+		ifs.read(reinterpret_cast<char*>(layer.value.data()), sizeof(layer.value[0]) * layer.value.size());
+		ifs.read(reinterpret_cast<char*>(layer.bias.data()), sizeof(layer.bias[0]) * layer.bias.size());
+		if (!ifs)
+			return false;
+
+		srcSize = layer.size;
+	}
+
+	return snn.setLayers(inputLayerSize, SparseFormat(format), std::move(layers));
+}
+
+template<typename T>
+bool LAFileIO::outputSparseNeuralNetwork(std::string path, const SparseNeuralNetwork<T>& snn)
+{
+	std::ofstream ofs(path, std::ios::out | std::ios::binary);
+	if (!ofs)
+		return false;
+
+	return outputSparseNeuralNetwork(ofs, snn);
+}
+
+template<typename T>
+bool LAFileIO::outputSparseNeuralNetwork(std::ostream& ofs, const SparseNeuralNetwork<T>& snn)
+{
+	int32_t format = static_cast<int32_t>(snn.getFormat());
+	int inputLayerSize = snn.getInputLayerSize();
+	int layerNum = snn.getLayerNum();
+
+	ofs.write(reinterpret_cast<const char*>(&format), sizeof(format));
+	ofs.write(reinterpret_cast<const char*>(&inputLayerSize), sizeof(inputLayerSize));
+	ofs.write(reinterpret_cast<const char*>(&layerNum), sizeof(layerNum));
+	for (int n = 0; n < layerNum; ++n)
+	{
+		const SparseLayer<T>& layer = snn.getLayer(n);
+		int32_t actFnc = encodeActFnc(layer.actFncID, layer.precision);
+		int32_t elementNum = static_cast<int32_t>(layer.index.size());
+		ofs.write(reinterpret_cast<const char*>(&layer.size), sizeof(layer.size));
+		ofs.write(reinterpret_cast<const char*>(&actFnc), sizeof(actFnc));
+		ofs.write(reinterpret_cast<const char*>(&elementNum), sizeof(elementNum));
+		ofs.write(reinterpret_cast<const char*>(layer.rowBegin.data()), sizeof(layer.rowBegin[0]) * layer.rowBegin.size());
+		ofs.write(reinterpret_cast<const char*>(layer.index.data()), sizeof(layer.index[0]) * layer.index.size());
+		ofs.write(reinterpret_cast<const char*>(layer.value.data()), sizeof(layer.value[0]) * layer.value.size());
+		ofs.write(reinterpret_cast<const char*>(layer.bias.data()), sizeof(layer.bias[0]) * layer.bias.size());
+	}
+
+	return static_cast<bool>(ofs);
+}
+
 template<typename Gene, typename Fitness>
 inline bool LAFileIO::inputGeneticAlgorithm(std::string path, GeneticAlgorithm<Gene, Fitness>& ga)
 {
@@ -133,6 +414,12 @@ inline bool LAFileIO::outputGeneticAlgorithm(std::string path, const GeneticAlgo
 	if (!ofs)
 		return false;
 
+	return outputGeneticAlgorithm(ofs, ga);
+}
+
+template<typename Gene, typename Fitness>
+inline bool LAFileIO::outputGeneticAlgorithm(std::ostream& ofs, const GeneticAlgorithm<Gene, Fitness>& ga)
+{
 	int generation = ga.getGeneration();
 	int population = ga.getPopulation();
 	int chromosomeLength = ga.getChromosomeLength();
@@ -149,5 +436,5 @@ inline bool LAFileIO::outputGeneticAlgorithm(std::string path, const GeneticAlgo
 	ofs.write(reinterpret_cast<const char*>(ga.getIndividuals()), sizeof(ga.getIndividuals()[0]) * population * chromosomeLength);
 	ofs.write(reinterpret_cast<const char*>(ga.getFitnesses()), sizeof(ga.getFitnesses()[0]) * population);
 
-	return true;
+	return static_cast<bool>(ofs);
 }
@@ -1,7 +1,11 @@
 #include "NeuralNetwork.h"
+#include "PopulationNeuralNetwork.h"
 #include "GeneticAlgorithm.h"
 #include "ActFncOperator.h"
 #include "LAFileIO.h"
+#include "QuantizedNeuralNetwork.h"
+#include "SparseNeuralNetwork.h"
+#include "FixedNeuralNetwork.h"
 
 #include <iostream>
 #include <iomanip>
@@ -121,22 +125,23 @@ int main(void)
 	// S̂ꂼ̓Kx
 	int fitness[POPULATION] = {};
 
+	// GȂS̂܂Ƃ߂ď`d邽߂NN
+	PopulationNeuralNetwork<int> pnn;
+	pnn.setStructure(nn);
+
 	while (true)
 	{
-		// GȂS̂NN̓o͂mFAKxvZ
+		// GȂS̂̐F̂NN̏d݂ƂĐݒ肵ASĂ̓͂܂Ƃ߂ď`d
+		int output[POPULATION * 4] = {};
+		pnn.setIndividuals(ga.getIndividuals(), POPULATION);
+		pnn.forwardPropagation(&input[0][0], 4, output);
+
+		// 덷قǓKxႭȂ悤ɌvZ
 		for (int pop = 0; pop < POPULATION; ++pop)
 		{
-			// popԖڂ̌̂̐F̂NN̏d݂ɐݒ
-			nn.setWeight(ga.getIndividual(pop));
 			fitness[pop] = 0;
 			for (int i = 0; i < 4; ++i)
-			{
-				// NN`d
-				const int* output = nn.forwardPropagation(input[i]);
-
-				// 덷قǓKxႭȂ悤ɌvZ
-				fitness[pop] += -std::abs(output[0] - idealOutput[i]);
-			}
+				fitness[pop] += -std::abs(output[pop * 4 + i] - idealOutput[i]);
 		}
 
 		// vZKxݒ
@@ -158,8 +163,8 @@ int main(void)
 
 		// ȉAG[g̂œKꂽmF
 
-		// G[g̂NNɃZbg
-		nn.setWeight(ga.getIndividual(0));
+		// G[g̂̐F̂Rs[NN̏d݂ƂĎ؂ (オiނƓeς̂Ŗ؂蒼)
+		nn.bindWeight(std::span<const int>(ga.getIndividual(0), nn.getWeightSize()));
 
 		// 덷̌vZ
 		int e = 0;
@@ -213,6 +218,50 @@ int main(void)
 		printNeuralNetwork(nn2);
 	}
 
+	// NeuralNetworkNXft@Cœo (}bvd݂Rs[Ɏg)
+	{
+		LAFileIO::outputNeuralNetworkModel("modelNN.dat", nn);
+
+		MappedModel<int> model;
+		model.open("modelNN.dat");
+
+		std::cout << std::endl << "+===+===+===+ ft@CNN擾 +===+===+===+" << std::endl;
+		printNeuralNetwork(model.getNeuralNetwork());
+	}
+
+	// NeuralNetworkNXint8ɗʎqČNNƔr
+	{
+		QuantizedNeuralNetwork<int8_t> qnn;
+		qnn.quantize(nn, &input[0][0], 4);
+		QuantizationReport report = qnn.compare(nn, &input[0][0], 4);
+
+		std::cout << std::endl << "+===+===+===+ NNʎq +===+===+===+" << std::endl;
+		std::cout << "덷̍ő = " << report.maxError << std::endl;
+		std::cout << "덷̕ = " << report.meanError << std::endl;
+		std::cout << "d݂̃oCg = " << report.originalBytes << "  " << report.quantizedBytes << std::endl;
+	}
+
+	// NeuralNetworkNX0̏d݂}肵đaȌ`ŏ`d (o͂͌NNƓ)
+	{
+		SparseNeuralNetwork<int> snn;
+		snn.prune(nn, 0);
+
+		std::cout << std::endl << "+===+===+===+ NN} +===+===+===+" << std::endl;
+		std::cout << "d݂̐ = " << snn.getDenseWeightNum() << "  " << snn.getStoredWeightNum() << std::endl;
+		for (int i = 0; i < 4; ++i)
+			std::cout << "(" << input[i][0] << ", " << input[i][1] << ") = " << snn.forwardPropagation(input[i])[0] << std::endl;
+	}
+
+	// w̑傫RpCɌ߂NNɓd݂ǂݍŏ`d
+	{
+		FixedNeuralNetwork<int, 2, FixedLayer<2, ActFncID::RELU>, FixedLayer<1, ActFncID::STEP>> fnn;
+		fnn.fromNeuralNetwork(nn);
+
+		std::cout << std::endl << "+===+===+===+ Œ̍\NN +===+===+===+" << std::endl;
+		for (int i = 0; i < 4; ++i)
+			std::cout << "(" << input[i][0] << ", " << input[i][1] << ") = " << fnn.forwardPropagation(input[i])[0] << std::endl;
+	}
+
 	// GeneticAlgorithmNXt@Co
 	{
 		LAFileIO::outputGeneticAlgorithm("dataGA.dat", ga);
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/*
+* t@CŜǂݏ\ȃRs[ICgŃɃ}bv
+*
+* y[WvZXpɃRs[At@Cɂ͔fȂ
+* ĂȂy[W͓t@C}bṽvZXƃy[WLbVL
+*/
+class MappedFile
+{
+public:
+	MappedFile() = default;
+
+	~MappedFile()
+	{
+		close();
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+public:
+	// @return }bvłȂꍇfalse
+	bool open(const std::string& path)
+	{
+		close();
+#if defined(_WIN32)
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+		LARGE_INTEGER size = {};
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (mapping == nullptr)
+			return false;
+		void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+		CloseHandle(mapping);
+		if (data == nullptr)
+			return false;
+		m_size = static_cast<uint64_t>(size.QuadPart);
+#else
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+		struct stat st = {};
+		if (fstat(fd, &st) != 0 || st.st_size == 0)
+		{
+			::close(fd);
+			return false;
+		}
+		void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (data == MAP_FAILED)
+			return false;
+		m_size = static_cast<uint64_t>(st.st_size);
+#endif
+		m_data = static_cast<char*>(data);
+		return true;
+	}
+
+	void close()
+	{
+		if (m_data == nullptr)
+			return;
+#if defined(_WIN32)
+		UnmapViewOfFile(m_data);
+#else
+		munmap(m_data, static_cast<size_t>(m_size));
+#endif
+		m_data = nullptr;
+		m_size = 0;
+	}
+
+	// @return }bv擪 (JĂȂnullptr)
+	char* getData() const
+	{
+		return m_data;
+	}
+
+	// @return }bvoCg
+	uint64_t getSize() const
+	{
+		return m_size;
+	}
+
+private:
+	char* m_data = nullptr;
+	uint64_t m_size = 0;
+};
@@ -0,0 +1,959 @@
+#pragma once
+
+#include "GeneticAlgorithm.h"
+#include "IslandGeneticAlgorithm.h"
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <afunix.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#endif
+
+/*
+* f̃vZXԒʐM
+*
+* eʁX̃vZXœAR[fBl[^Ĉږ肷
+*
+* AhX̏
+*   "unix:pX"               UnixhC\Pbg
+*   "tcp:zXg:|[gԍ"   TCP ( "tcp:127.0.0.1:5000")
+*
+* bZ[W̏ (oCgI[_[͎s̂܂)
+*   MigrationHeader
+*   F (migrantNum * chromosomeLength Gene)
+*     LAFileIO::outputGeneticAlgorithm֐oS̂̐F̂̔zƓ
+*/
+struct MigrationHeader
+{
+	static constexpr uint32_t MAGIC = 0x474d414c; // "LAMG"
+
+	enum Type : uint16_t
+	{
+		JOIN = 1,    //   R[fBl[^ Q̗v
+		WELCOME = 2, // R[fBl[^   Q̏F (islandɓ̔ԍ)
+		MIGRANT = 3  // ږ
+	};
+
+	uint32_t magic;
+	uint16_t type;
+	uint16_t geneSize;
+	int32_t island;
+	int32_t generation;
+	int32_t chromosomeLength;
+	int32_t migrantNum;
+	uint16_t geneFloat; // F̂_Ȃ1 (intfloat͑傫Ȃ̂ŋʂ)
+	uint16_t reserved;
+
+	// bZ[W̐F̂̃oCg̏ (𒴂wb_͉ĂƂ݂Ȃ)
+	static constexpr int64_t PAYLOAD_LIMIT = 16 * 1024 * 1024;
+
+	// @return wb_ɑF̂̃oCg (̐PAYLOAD_LIMIT𒴂ꍇ-1)
+	int64_t payloadSize() const
+	{
+		if (migrantNum < 0 || chromosomeLength < 0)
+			return -1;
+		// |OɂPƔׂ̂ŁAint64_tňȂ
+		const int64_t chromosomeBytes = static_cast<int64_t>(chromosomeLength) * geneSize;
+		if (chromosomeBytes > PAYLOAD_LIMIT || (chromosomeBytes > 0 && migrantNum > PAYLOAD_LIMIT / chromosomeBytes))
+			return -1;
+		return chromosomeBytes * migrantNum;
+	}
+};
+
+/*
+* \Pbg (POSIXWinsock̈Ⴂz)
+*/
+class MigrationSocket
+{
+public:
+#if defined(_WIN32)
+	using Handle = SOCKET;
+	using PollFd = WSAPOLLFD;
+	static constexpr Handle INVALID = INVALID_SOCKET;
+#else
+	using Handle = int;
+	using PollFd = pollfd;
+	static constexpr Handle INVALID = -1;
+#endif
+
+	/*
+	* ҂󂯂Jn
+	*
+	* @param address AhX
+	* @return ҂󂯃\Pbg (sINVALID)
+	*/
+	static Handle listen(const std::string& address)
+	{
+		startup();
+		sockaddr_storage storage = {};
+		socklen_t length = 0;
+		if (!resolve(address, storage, length))
+			return INVALID;
+
+		Handle handle = socket(storage.ss_family, SOCK_STREAM, 0);
+		if (handle == INVALID)
+			return INVALID;
+
+		if (storage.ss_family == AF_UNIX)
+		{
+			// O̎sŎc\Pbgt@C
+			std::string path = address.substr(5);
+#if defined(_WIN32)
+			DeleteFileA(path.c_str());
+#else
+			unlink(path.c_str());
+#endif
+		}
+		else
+		{
+			int yes = 1;
+			setsockopt(handle, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&yes), sizeof(yes));
+		}
+
+		if (bind(handle, reinterpret_cast<sockaddr*>(&storage), length) != 0 || ::listen(handle, SOMAXCONN) != 0)
+		{
+			close(handle);
+			return INVALID;
+		}
+		setNonBlocking(handle);
+		return handle;
+	}
+
+	/*
+	* ڑ
+	*
+	* @param address AhX
+	* @return ڑ\Pbg (sINVALID)
+	*/
+	static Handle connect(const std::string& address)
+	{
+		startup();
+		sockaddr_storage storage = {};
+		socklen_t length = 0;
+		if (!resolve(address, storage, length))
+			return INVALID;
+
+		Handle handle = socket(storage.ss_family, SOCK_STREAM, 0);
+		if (handle == INVALID)
+			return INVALID;
+		if (::connect(handle, reinterpret_cast<sockaddr*>(&storage), length) != 0)
+		{
+			close(handle);
+			return INVALID;
+		}
+		if (storage.ss_family != AF_UNIX)
+		{
+			int yes = 1;
+			setsockopt(handle, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&yes), sizeof(yes));
+		}
+		return handle;
+	}
+
+	// @return 󂯕t\Pbg (ȂINVALID)
+	static Handle accept(Handle listener)
+	{
+		Handle handle = ::accept(listener, nullptr, nullptr);
+		if (handle != INVALID)
+			setNonBlocking(handle);
+		return handle;
+	}
+
+	static void close(Handle handle)
+	{
+#if defined(_WIN32)
+		closesocket(handle);
+#else
+		::close(handle);
+#endif
+	}
+
+	static void setNonBlocking(Handle handle)
+	{
+#if defined(_WIN32)
+		u_long yes = 1;
+		ioctlsocket(handle, FIONBIO, &yes);
+#else
+		fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK);
+#endif
+	}
+
+	// @return MoCg (Ȃꍇ0AؒfEG[̏ꍇ-1)
+	static int send(Handle handle, const char* data, int size)
+	{
+#if defined(_WIN32)
+		int result = ::send(handle, data, size, 0);
+		if (result < 0)
+			return WSAGetLastError() == WSAEWOULDBLOCK ? 0 : -1;
+#else
+		int result = static_cast<int>(::send(handle, data, size, MSG_NOSIGNAL));
+		if (result < 0)
+			return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+#endif
+		return result;
+	}
+
+	// @return MoCg (͂ĂȂꍇ0AؒfEG[̏ꍇ-1)
+	static int receive(Handle handle, char* data, int size)
+	{
+#if defined(_WIN32)
+		int result = ::recv(handle, data, size, 0);
+		if (result < 0)
+			return WSAGetLastError() == WSAEWOULDBLOCK ? 0 : -1;
+#else
+		int result = static_cast<int>(::recv(handle, data, size, 0));
+		if (result < 0)
+			return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+#endif
+		return result == 0 ? -1 : result;
+	}
+
+	static int poll(PollFd* fds, int num, int timeoutMs)
+	{
+#if defined(_WIN32)
+		return WSAPoll(fds, static_cast<ULONG>(num), timeoutMs);
+#else
+		return ::poll(fds, static_cast<nfds_t>(num), timeoutMs);
+#endif
+	}
+
+private:
+	static void startup()
+	{
+#if defined(_WIN32)
+		static const bool started = []()
+		{
+			WSADATA data;
+			return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+		}();
+		(void)started;
+#endif
+	}
+
+	static bool resolve(const std::string& address, sockaddr_storage& storage, socklen_t& length)
+	{
+		if (address.compare(0, 5, "unix:") == 0)
+		{
+			std::string path = address.substr(5);
+			sockaddr_un* un = reinterpret_cast<sockaddr_un*>(&storage);
+			if (path.size() >= sizeof(un->sun_path))
+				return false;
+			un->sun_family = AF_UNIX;
+			memcpy(un->sun_path, path.c_str(), path.size() + 1);
+			length = static_cast<socklen_t>(sizeof(sockaddr_un));
+			return true;
+		}
+		if (address.compare(0, 4, "tcp:") == 0)
+		{
+			size_t colon = address.rfind(':');
+			if (colon <= 4)
+				return false;
+			std::string host = address.substr(4, colon - 4);
+			sockaddr_in* in = reinterpret_cast<sockaddr_in*>(&storage);
+			in->sin_family = AF_INET;
+			const char* portBegin = address.data() + colon + 1;
+			const char* portEnd = address.data() + address.size();
+			uint16_t port = 0;
+			auto result = std::from_chars(portBegin, portEnd, port);
+			if (result.ec != std::errc() || result.ptr != portEnd || portBegin == portEnd)
+				return false;
+			in->sin_port = htons(port);
+			if (inet_pton(AF_INET, host.c_str(), &in->sin_addr) != 1)
+				return false;
+			length = static_cast<socklen_t>(sizeof(sockaddr_in));
+			return true;
+		}
+		return false;
+	}
+
+private:
+	MigrationSocket() = delete;
+};
+
+/*
+* ̃vZXȂR[fBl[^
+*
+* ̈ږ󂯎Ag|W[ɏ]đ̓֒p
+* ͂łQEEłARINGł͎QĂ铇ԍɂȂւɂȂ
+* ̑M҂𒴂ĂꍇÄږ͎̂Ă
+* ꂽwb_ (F̂MigrationHeader::PAYLOAD_LIMIT𒴂́AQƐF̂̒E^قȂ) 𑗂͐ؒf
+*
+* start֐ŕʃXbhœn߁Astop֐܂̓fXgN^Ŏ~܂
+*/
+class MigrationCoordinator
+{
+public:
+	MigrationCoordinator();
+	~MigrationCoordinator();
+
+	MigrationCoordinator(const MigrationCoordinator&) = delete;
+	MigrationCoordinator& operator=(const MigrationCoordinator&) = delete;
+
+public:
+	/*
+	* ҂󂯂JnApp̃XbhN
+	*
+	* @param address  AhX
+	* @param topology ږ𑗂 (RING = ̓̂݁AFULLY_CONNECTED = ̑SĂ̓)
+	* @return ҂󂯂JnłȂꍇfalse
+	*/
+	bool start(const std::string& address, MigrationTopology topology);
+
+	// pp̃Xbh~߁ASĂ̐ڑ
+	void stop();
+
+	// @return ݎQĂ铇̐
+	int getIslandNum() const;
+
+	// @return pږbZ[W̐
+	int64_t getRelayedNum() const;
+
+	// @return 悪l܂ĂĎ̂ĂږbZ[W̐
+	int64_t getDroppedNum() const;
+
+public:
+	// Ƃ̑M҂̏ (oCg)
+	static constexpr size_t SEND_LIMIT = 16 * 1024 * 1024;
+
+private:
+	struct Island
+	{
+		MigrationSocket::Handle handle = MigrationSocket::INVALID;
+		int id = -1;
+		int chromosomeLength = 0;
+		int geneSize = 0;
+		int geneFloat = 0;
+		std::vector<char> received;
+		std::vector<char> sending;
+	};
+
+	void run();
+	bool receive(Island& island);
+	bool flush(Island& island);
+	void relay(const Island& from, const char* message, size_t size);
+
+private:
+	MigrationSocket::Handle m_listener;
+	MigrationTopology m_topology;
+	std::vector<std::unique_ptr<Island>> m_islands;
+	int m_nextId;
+	std::thread m_thread;
+	std::atomic<bool> m_running;
+	std::atomic<int> m_islandNum;
+	std::atomic<int64_t> m_relayedNum;
+	std::atomic<int64_t> m_droppedNum;
+};
+
+/*
+* template<typename Gene, typename Fitness>
+* Gene    F̂̌^ intEfloatEdouble
+* Fitness Kx̌^ intEfloatEdouble
+*
+* R[fBl[^ɐڑĈږ肷铇̃NX
+*
+* g (Pゲ)
+*   ga.evaluate(fitnesses);
+*   if (ڏZ̐) client.emigrate(ga, fitnesses, ږ̐);
+*   ga.generateNextGeneration();
+*   client.immigrate(ga);
+*
+* R[fBl[^Ƃ̐ڑ؂ĂGA͂̂܂ܒPƂŐi𑱂
+*/
+template<typename Gene, typename Fitness>
+class MigrationClient
+{
+public:
+	MigrationClient();
+	~MigrationClient();
+
+	MigrationClient(const MigrationClient&) = delete;
+	MigrationClient& operator=(const MigrationClient&) = delete;
+
+public:
+	/*
+	* R[fBl[^ɐڑēƂĎQ
+	*
+	* Q̏FtimeoutMs~b܂ő҂A͂ȂΐڑĎsƂ
+	* (ȂɐڑĂAGAi߂Ȃ܂܎~܂葱Ȃ悤ɂ)
+	*
+	* @param address          R[fBl[^̃AhX
+	* @param chromosomeLength F̂̒ (̓Ƃ݈̂ږ肷)
+	* @param timeoutMs        F҂ (~b) Pȏ
+	* @return ڑEQłȂꍇAԓɏFȂꍇfalse
+	*/
+	bool connect(const std::string& address, int chromosomeLength, int timeoutMs = CONNECT_TIMEOUT_MS);
+
+	// ڑ
+	void disconnect();
+
+	/*
+	* Kx̍̂ږƂđ
+	*
+	* M͑҂ɍsAM҂𒴂Ăꍇ͎̂Ă
+	*
+	* @param ga         ږ𑗂铇
+	* @param fitnesses  gȃS̂̓Kx
+	* @param migrantNum ̐
+	* @return M҂ɐς߂ꍇtrue
+	*/
+	bool emigrate(const GeneticAlgorithm<Gene, Fitness>& ga, const Fitness* fitnesses, int migrantNum);
+
+	/*
+	* ͂ĂږG[gȊǑ̂Ɠւ
+	*
+	* ҂ɖ߂ ږ̓CfbNX̑傫㏑
+	*
+	* @param ga ږ󂯓铇
+	* @return 󂯓ꂽ̐
+	*/
+	int immigrate(GeneticAlgorithm<Gene, Fitness>& ga);
+
+	// @return R[fBl[^ɐڑĂꍇtrue
+	bool isConnected() const;
+
+	// @return R[fBl[^蓖Ă̔ԍ
+	int getIslandID() const;
+
+public:
+	// M҂̏ (oCg)
+	static constexpr size_t SEND_LIMIT = 16 * 1024 * 1024;
+
+	// connect֐ŎQ̏F҂Ԃ̏l (~b)
+	static constexpr int CONNECT_TIMEOUT_MS = 5000;
+
+private:
+	bool flush();
+	bool receive();
+
+private:
+	MigrationSocket::Handle m_handle;
+	int m_islandID;
+	int m_chromosomeLength;
+	std::vector<char> m_received;
+	std::vector<char> m_sending;
+	std::unique_ptr<int[]> m_order;
+	int m_orderSize;
+	std::vector<Gene> m_immigrant; // Mobt@̐F̂͋EĂȂ̂ŁAɃRs[Ăg
+};
+
+
+
+
+inline MigrationCoordinator::MigrationCoordinator()
+	: m_listener(MigrationSocket::INVALID)
+	, m_topology(MigrationTopology::RING)
+	, m_islands()
+	, m_nextId()
+	, m_thread()
+	, m_running(false)
+	, m_islandNum(0)
+	, m_relayedNum(0)
+	, m_droppedNum(0)
+{
+}
+
+inline MigrationCoordinator::~MigrationCoordinator()
+{
+	stop();
+}
+
+inline bool MigrationCoordinator::start(const std::string& address, MigrationTopology topology)
+{
+	stop();
+	m_listener = MigrationSocket::listen(address);
+	if (m_listener == MigrationSocket::INVALID)
+		return false;
+
+	m_topology = topology;
+	m_nextId = 0;
+	m_running = true;
+	m_thread = std::thread(&MigrationCoordinator::run, this);
+	return true;
+}
+
+inline void MigrationCoordinator::stop()
+{
+	if (m_thread.joinable())
+	{
+		m_running = false;
+		m_thread.join();
+	}
+	for (auto& island : m_islands)
+		MigrationSocket::close(island->handle);
+	m_islands.clear();
+	m_islandNum = 0;
+	if (m_listener != MigrationSocket::INVALID)
+	{
+		MigrationSocket::close(m_listener);
+		m_listener = MigrationSocket::INVALID;
+	}
+}
+
+inline int MigrationCoordinator::getIslandNum() const
+{
+	return m_islandNum;
+}
+
+inline int64_t MigrationCoordinator::getRelayedNum() const
+{
+	return m_relayedNum;
+}
+
+inline int64_t MigrationCoordinator::getDroppedNum() const
+{
+	return m_droppedNum;
+}
+
+inline void MigrationCoordinator::run()
+{
+	std::vector<MigrationSocket::PollFd> fds;
+	while (m_running)
+	{
+		// ҂󂯃\PbgƑSĂ̓Ď (stopmł悤莞ԂŖ߂)
+		fds.resize(m_islands.size() + 1);
+		fds[0] = {};
+		fds[0].fd = m_listener;
+		fds[0].events = POLLIN;
+		for (size_t i = 0; i < m_islands.size(); ++i)
+		{
+			fds[i + 1] = {};
+			fds[i + 1].fd = m_islands[i]->handle;
+			fds[i + 1].events = static_cast<short>(POLLIN | (m_islands[i]->sending.empty() ? 0 : POLLOUT));
+		}
+		if (MigrationSocket::poll(fds.data(), static_cast<int>(fds.size()), 100) <= 0)
+			continue;
+
+		// rQ铇󂯕t
+		if (fds[0].revents & POLLIN)
+		{
+			MigrationSocket::Handle handle;
+			while ((handle = MigrationSocket::accept(m_listener)) != MigrationSocket::INVALID)
+			{
+				auto island = std::make_unique<Island>();
+				island->handle = handle;
+				m_islands.push_back(std::move(island));
+			}
+		}
+
+		// MEMAؒfꂽ菜
+		size_t polled = fds.size() - 1;
+		for (size_t i = 0; i < polled; ++i)
+		{
+			Island& island = *m_islands[i];
+			short revents = fds[i + 1].revents;
+			bool alive = true;
+			if (revents & (POLLIN | POLLHUP | POLLERR))
+				alive = receive(island);
+			if (alive && (revents & POLLOUT))
+				alive = flush(island);
+			if (!alive)
+			{
+				MigrationSocket::close(island.handle);
+				island.handle = MigrationSocket::INVALID;
+			}
+		}
+		m_islands.erase(std::remove_if(m_islands.begin(), m_islands.end(), [](const std::unique_ptr<Island>& island)
+			{ return island->handle == MigrationSocket::INVALID; }
+		), m_islands.end());
+
+		int joined = 0;
+		for (auto& island : m_islands)
+			joined += island->id >= 0 ? 1 : 0;
+		m_islandNum = joined;
+	}
+}
+
+inline bool MigrationCoordinator::receive(Island& island)
+{
+	char buffer[64 * 1024];
+	while (true)
+	{
+		// xɗ߂͍̂ő̃bZ[WP܂ (c͏Ă玟pollœǂ)
+		if (island.received.size() >= sizeof(MigrationHeader) + MigrationHeader::PAYLOAD_LIMIT)
+			break;
+		int size = MigrationSocket::receive(island.handle, buffer, sizeof(buffer));
+		if (size < 0)
+			return false;
+		if (size == 0)
+			break;
+		island.received.insert(island.received.end(), buffer, buffer + size);
+	}
+
+	// bZ[Wɏ
+	size_t offset = 0;
+	while (island.received.size() - offset >= sizeof(MigrationHeader))
+	{
+		MigrationHeader header;
+		memcpy(&header, &island.received[offset], sizeof(header));
+		if (header.magic != MigrationHeader::MAGIC || header.payloadSize() < 0)
+			return false;
+
+		// Q̗v͂P񂾂Aږ͎QƓF̂̒E^̂ݎ󂯕t
+		if (header.type == MigrationHeader::JOIN)
+		{
+			if (island.id >= 0 || header.migrantNum != 0 || header.chromosomeLength <= 0 || (header.geneSize != sizeof(int) && header.geneSize != sizeof(double)))
+				return false;
+		}
+		else if (header.type == MigrationHeader::MIGRANT)
+		{
+			if (island.id < 0 || header.chromosomeLength != island.chromosomeLength || header.geneSize != island.geneSize || header.geneFloat != island.geneFloat)
+				return false;
+		}
+		else
+		{
+			return false;
+		}
+
+		size_t messageSize = sizeof(header) + static_cast<size_t>(header.payloadSize());
+		if (island.received.size() - offset < messageSize)
+			break;
+
+		if (header.type == MigrationHeader::JOIN)
+		{
+			island.id = m_nextId++;
+			island.chromosomeLength = header.chromosomeLength;
+			island.geneSize = header.geneSize;
+			island.geneFloat = header.geneFloat;
+
+			MigrationHeader welcome = header;
+			welcome.type = MigrationHeader::WELCOME;
+			welcome.island = island.id;
+			welcome.migrantNum = 0;
+			const char* data = reinterpret_cast<const char*>(&welcome);
+			island.sending.insert(island.sending.end(), data, data + sizeof(welcome));
+		}
+		else
+		{
+			relay(island, &island.received[offset], messageSize);
+		}
+		offset += messageSize;
+	}
+	island.received.erase(island.received.begin(), island.received.begin() + offset);
+	return flush(island);
+}
+
+inline bool MigrationCoordinator::flush(Island& island)
+{
+	size_t offset = 0;
+	while (offset < island.sending.size())
+	{
+		int size = MigrationSocket::send(island.handle, &island.sending[offset], static_cast<int>(std::min<size_t>(island.sending.size() - offset, 1 << 30)));
+		if (size < 0)
+			return false;
+		if (size == 0)
+			break;
+		offset += size;
+	}
+	island.sending.erase(island.sending.begin(), island.sending.begin() + offset);
+	return true;
+}
+
+inline void MigrationCoordinator::relay(const Island& from, const char* message, size_t size)
+{
+	// RINGł͔ԍɑ傫 (Ȃ΍ł) ֑
+	Island* next = nullptr;
+	Island* first = nullptr;
+	for (auto& island : m_islands)
+	{
+		Island& to = *island;
+		if (&to == &from || to.id < 0 || to.handle == MigrationSocket::INVALID)
+			continue;
+		if (to.chromosomeLength != from.chromosomeLength || to.geneSize != from.geneSize || to.geneFloat != from.geneFloat)
+			continue;
+
+		if (m_topology == MigrationTopology::FULLY_CONNECTED)
+		{
+			if (to.sending.size() + size > SEND_LIMIT)
+			{
+				++m_droppedNum;
+				continue;
+			}
+			to.sending.insert(to.sending.end(), message, message + size);
+			++m_relayedNum;
+			continue;
+		}
+
+		if (to.id > from.id && (next == nullptr || to.id < next->id))
+			next = &to;
+		if (first == nullptr || to.id < first->id)
+			first = &to;
+	}
+
+	if (m_topology == MigrationTopology::RING)
+	{
+		Island* to = next != nullptr ? next : first;
+		if (to == nullptr)
+			return;
+		if (to->sending.size() + size > SEND_LIMIT)
+		{
+			++m_droppedNum;
+			return;
+		}
+		to->sending.insert(to->sending.end(), message, message + size);
+		++m_relayedNum;
+	}
+}
+
+
+
+
+template<typename Gene, typename Fitness>
+inline MigrationClient<Gene, Fitness>::MigrationClient()
+	: m_handle(MigrationSocket::INVALID)
+	, m_islandID(-1)
+	, m_chromosomeLength()
+	, m_received()
+	, m_sending()
+	, m_order()
+	, m_orderSize()
+	, m_immigrant()
+{
+}
+
+template<typename Gene, typename Fitness>
+inline MigrationClient<Gene, Fitness>::~MigrationClient()
+{
+	disconnect();
+}
+
+template<typename Gene, typename Fitness>
+inline bool MigrationClient<Gene, Fitness>::connect(const std::string& address, int chromosomeLength, int timeoutMs)
+{
+	disconnect();
+	m_handle = MigrationSocket::connect(address);
+	if (m_handle == MigrationSocket::INVALID)
+		return false;
+	m_chromosomeLength = chromosomeLength;
+	m_immigrant.resize(chromosomeLength);
+
+	// QvAF܂ő҂
+	MigrationHeader join = {};
+	join.magic = MigrationHeader::MAGIC;
+	join.type = MigrationHeader::JOIN;
+	join.geneSize = sizeof(Gene);
+	join.geneFloat = std::is_floating_point_v<Gene> ? 1 : 0;
+	join.island = -1;
+	join.chromosomeLength = chromosomeLength;
+	const char* data = reinterpret_cast<const char*>(&join);
+	size_t offset = 0;
+	while (offset < sizeof(join))
+	{
+		int size = MigrationSocket::send(m_handle, data + offset, static_cast<int>(sizeof(join) - offset));
+		if (size <= 0)
+		{
+			disconnect();
+			return false;
+		}
+		offset += size;
+	}
+
+	MigrationHeader welcome = {};
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(timeoutMs, 1));
+	offset = 0;
+	while (offset < sizeof(welcome))
+	{
+		// ǂ߂悤ɂȂ܂ŁAc莞Ԃ҂
+		const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+		MigrationSocket::PollFd fd = {};
+		fd.fd = m_handle;
+		fd.events = POLLIN;
+		if (remaining <= 0 || MigrationSocket::poll(&fd, 1, static_cast<int>(remaining)) <= 0)
+		{
+			disconnect();
+			return false;
+		}
+
+		int size = MigrationSocket::receive(m_handle, reinterpret_cast<char*>(&welcome) + offset, static_cast<int>(sizeof(welcome) - offset));
+		if (size <= 0)
+		{
+			disconnect();
+			return false;
+		}
+		offset += size;
+	}
+	if (welcome.magic != MigrationHeader::MAGIC || welcome.type != MigrationHeader::WELCOME)
+	{
+		disconnect();
+		return false;
+	}
+
+	m_islandID = welcome.island;
+	MigrationSocket::setNonBlocking(m_handle);
+	return true;
+}
+
+template<typename Gene, typename Fitness>
+inline void MigrationClient<Gene, Fitness>::disconnect()
+{
+	if (m_handle != MigrationSocket::INVALID)
+		MigrationSocket::close(m_handle);
+	m_handle = MigrationSocket::INVALID;
+	m_islandID = -1;
+	m_received.clear();
+	m_sending.clear();
+}
+
+template<typename Gene, typename Fitness>
+inline bool MigrationClient<Gene, Fitness>::emigrate(const GeneticAlgorithm<Gene, Fitness>& ga, const Fitness* fitnesses, int migrantNum)
+{
+	if (!isConnected())
+		return false;
+
+	const int population = ga.getPopulation();
+	migrantNum = std::min(migrantNum, population);
+	const size_t messageSize = sizeof(MigrationHeader) + sizeof(Gene) * migrantNum * m_chromosomeLength;
+	if (migrantNum <= 0 || m_sending.size() + messageSize > SEND_LIMIT)
+		return false;
+
+	// KxɈږI
+	if (m_orderSize < population)
+	{
+		m_order.reset(new int[population]);
+		m_orderSize = population;
+	}
+	for (int i = 0; i < population; ++i)
+		m_order[i] = i;
+	std::partial_sort(m_order.get(), m_order.get() + migrantNum, m_order.get() + population, [fitnesses](int lhs, int rhs)
+		{ return fitnesses[lhs] > fitnesses[rhs]; }
+	);
+
+	MigrationHeader header = {};
+	header.magic = MigrationHeader::MAGIC;
+	header.type = MigrationHeader::MIGRANT;
+	header.geneSize = sizeof(Gene);
+	header.geneFloat = std::is_floating_point_v<Gene> ? 1 : 0;
+	header.island = m_islandID;
+	header.generation = ga.getGeneration();
+	header.chromosomeLength = m_chromosomeLength;
+	header.migrantNum = migrantNum;
+
+	size_t offset = m_sending.size();
+	m_sending.resize(offset + messageSize);
+	memcpy(&m_sending[offset], &header, sizeof(header));
+	offset += sizeof(header);
+	for (int i = 0; i < migrantNum; ++i)
+	{
+		memcpy(&m_sending[offset], ga.getIndividual(m_order[i]), sizeof(Gene) * m_chromosomeLength);
+		offset += sizeof(Gene) * m_chromosomeLength;
+	}
+
+	if (!flush())
+		disconnect();
+	return true;
+}
+
+template<typename Gene, typename Fitness>
+inline int MigrationClient<Gene, Fitness>::immigrate(GeneticAlgorithm<Gene, Fitness>& ga)
+{
+	if (!isConnected())
+		return 0;
+	if (!flush() || !receive())
+	{
+		disconnect();
+		return 0;
+	}
+
+	// bZ[ẄږG[gȊǑ̂Ɠւ
+	int replace = ga.getPopulation() - 1;
+	int accepted = 0;
+	size_t offset = 0;
+	while (m_received.size() - offset >= sizeof(MigrationHeader))
+	{
+		MigrationHeader header;
+		memcpy(&header, &m_received[offset], sizeof(header));
+		if (header.magic != MigrationHeader::MAGIC || header.payloadSize() < 0)
+		{
+			disconnect();
+			return accepted;
+		}
+
+		size_t messageSize = sizeof(header) + static_cast<size_t>(header.payloadSize());
+		if (m_received.size() - offset < messageSize)
+			break;
+
+		if (header.type == MigrationHeader::MIGRANT && header.geneSize == sizeof(Gene) && header.geneFloat == (std::is_floating_point_v<Gene> ? 1 : 0) && header.chromosomeLength == m_chromosomeLength)
+		{
+			const char* chromosome = &m_received[offset + sizeof(header)];
+			for (int i = 0; i < header.migrantNum && replace >= ga.getEliteNum(); ++i)
+			{
+				memcpy(m_immigrant.data(), chromosome, sizeof(Gene) * m_chromosomeLength);
+				ga.setIndividual(replace--, m_immigrant.data());
+				chromosome += sizeof(Gene) * m_chromosomeLength;
+				++accepted;
+			}
+		}
+		offset += messageSize;
+	}
+	m_received.erase(m_received.begin(), m_received.begin() + offset);
+	return accepted;
+}
+
+template<typename Gene, typename Fitness>
+inline bool MigrationClient<Gene, Fitness>::isConnected() const
+{
+	return m_handle != MigrationSocket::INVALID;
+}
+
+template<typename Gene, typename Fitness>
+inline int MigrationClient<Gene, Fitness>::getIslandID() const
+{
+	return m_islandID;
+}
+
+template<typename Gene, typename Fitness>
+inline bool MigrationClient<Gene, Fitness>::flush()
+{
+	size_t offset = 0;
+	while (offset < m_sending.size())
+	{
+		int size = MigrationSocket::send(m_handle, &m_sending[offset], static_cast<int>(std::min<size_t>(m_sending.size() - offset, 1 << 30)));
+		if (size < 0)
+			return false;
+		if (size == 0)
+			break;
+		offset += size;
+	}
+	m_sending.erase(m_sending.begin(), m_sending.begin() + offset);
+	return true;
+}
+
+template<typename Gene, typename Fitness>
+inline bool MigrationClient<Gene, Fitness>::receive()
+{
+	char buffer[64 * 1024];
+	while (true)
+	{
+		// xɗ߂͍̂ő̃bZ[WP܂ (c͎immigrate֐œǂ)
+		if (m_received.size() >= sizeof(MigrationHeader) + MigrationHeader::PAYLOAD_LIMIT)
+			return true;
+		int size = MigrationSocket::receive(m_handle, buffer, sizeof(buffer));
+		if (size < 0)
+			return false;
+		if (size == 0)
+			return true;
+		m_received.insert(m_received.end(), buffer, buffer + size);
+	}
+}
@@ -0,0 +1,357 @@
+#pragma once
+
+#include "NeuralNetwork.h"
+#include "ActFncOperator.h"
+#include "MappedFile.h"
+#include <string>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+
+/*
+* NeuralNetwork̃ft@C̏
+*
+*   ModelHeader            (64oCg)
+*   ModelLayer * layerNum  (͑wAԑwAo͑w̏)
+*   0                  (d݂̐擪64oCgEɑ)
+*   d                   (NeuralNetwork::getWeight֐̔zƓ)
+*
+* d݂͑wƂɕP̘ÄɒûŁAmmapĂ̂܂܏d݂ƂĎg
+* oCgI[_[͏o̂܂܂ŁAقȂł͓ǂݍ߂Ȃ
+* checksum̓wb_ȍ~ (C\d݂̖܂) ModelFile::checksum֐ŋ߂l
+*
+* o[W1̃t@Cǂݍ߂ (ModelLayeractFncID4oCgŁA֐̐x͑SEXACT)
+*/
+struct ModelHeader
+{
+	static constexpr uint32_t MAGIC = 0x4e4e414c;      // "LANN"
+	static constexpr uint16_t VERSION = 2;
+	static constexpr uint32_t ENDIAN = 0x01020304;
+	static constexpr uint64_t ALIGNMENT = 64;
+
+	enum WeightType : uint16_t
+	{
+		INT32 = 1,
+		FLOAT64 = 2,
+		FLOAT32 = 3
+	};
+
+	uint32_t magic;
+	uint16_t version;
+	uint16_t headerSize;
+	uint32_t endian;
+	uint16_t weightType;
+	uint16_t weightBytes;
+	int32_t layerNum;
+	int32_t reserved;
+	int64_t weightSize;
+	uint64_t layerOffset;
+	uint64_t weightOffset;
+	uint64_t fileSize;
+	uint64_t checksum;
+};
+static_assert(sizeof(ModelHeader) == 64, "ModelHeader must be 64 bytes");
+
+struct ModelLayer
+{
+	int32_t size;               // m[h (oCAXm[h܂܂Ȃ)
+	int16_t actFncID;           // ֐ID (͑wł͖)
+	uint16_t actFncPrecision;   // ֐̌vZ̐x (͑wł͖)
+	int64_t weightIndex;        // Ȏw炱̑wւ̏d݂̐擪 (d݂̔z̃CfbNX ͑w0)
+};
+static_assert(sizeof(ModelLayer) == 16, "ModelLayer must be 16 bytes");
+
+/*
+* ft@C̏oƌ
+*/
+class ModelFile
+{
+public:
+	// @return TɑΉď݂^
+	template<typename T>
+	static constexpr ModelHeader::WeightType weightType()
+	{
+		if constexpr (std::is_same_v<T, int>)
+			return ModelHeader::INT32;
+		else if constexpr (std::is_same_v<T, float>)
+			return ModelHeader::FLOAT32;
+		else
+			return ModelHeader::FLOAT64;
+	}
+
+	/*
+	* nnft@Č`Ńɕׂ
+	*
+	* @param nn D܂Őݒ肵NeuralNetwork
+	* @param[out] header wb_
+	* @param[out] table  C\Əd݂̑O0 TCY = header.weightOffset - sizeof(ModelHeader)
+	*/
+	template<typename T>
+	static void layout(const NeuralNetwork<T>& nn, ModelHeader& header, std::unique_ptr<char[]>& table)
+	{
+		const int layerNum = nn.getHiddenLayerNum() + 2;
+		const uint64_t layerOffset = sizeof(ModelHeader);
+		const uint64_t weightOffset = align(layerOffset + sizeof(ModelLayer) * layerNum);
+		const uint64_t tableSize = weightOffset - layerOffset;
+		table.reset(new char[tableSize]);
+		memset(table.get(), 0, tableSize);
+
+		ModelLayer* layers = reinterpret_cast<ModelLayer*>(table.get());
+		for (int i = 0; i < layerNum; ++i)
+		{
+			if (i == 0)
+				layers[i].size = nn.getInputLayerSize();
+			else if (i == layerNum - 1)
+				layers[i].size = nn.getOutputLayerSize();
+			else
+				layers[i].size = nn.getHiddenLayerSize(i - 1);
+
+			if (i == 0)
+			{
+				layers[i].actFncID = 0;
+				layers[i].actFncPrecision = 0;
+			}
+			else if (i == layerNum - 1)
+			{
+				layers[i].actFncID = static_cast<int16_t>(nn.getOutputLayerActFncID());
+				layers[i].actFncPrecision = static_cast<uint16_t>(nn.getOutputLayerActFncPrecision());
+			}
+			else
+			{
+				layers[i].actFncID = static_cast<int16_t>(nn.getHiddenLayerActFncID(i - 1));
+				layers[i].actFncPrecision = static_cast<uint16_t>(nn.getHiddenLayerActFncPrecision(i - 1));
+			}
+
+			layers[i].weightIndex = i <= 1 ? 0 : layers[i - 1].weightIndex + static_cast<int64_t>(layers[i - 1].size) * (layers[i - 2].size + 1);
+		}
+
+		header = {};
+		header.magic = ModelHeader::MAGIC;
+		header.version = ModelHeader::VERSION;
+		header.headerSize = sizeof(ModelHeader);
+		header.endian = ModelHeader::ENDIAN;
+		header.weightType = weightType<T>();
+		header.weightBytes = sizeof(T);
+		header.layerNum = layerNum;
+		header.weightSize = nn.getWeightSize();
+		header.layerOffset = layerOffset;
+		header.weightOffset = weightOffset;
+		header.fileSize = weightOffset + sizeof(T) * nn.getWeightSize();
+		header.checksum = checksum(nn.getWeight(), sizeof(T) * nn.getWeightSize(), checksum(table.get(), tableSize));
+	}
+
+	/*
+	* ̃ft@C؂Ann̍\ (@`C) ݒ肷
+	*
+	* @param data   ft@C̐擪
+	* @param size   ft@C̃oCg
+	* @param verify truȅꍇchecksum؂ (dݑŜǂނ̂ő傫ȃfł͎Ԃ)
+	* @param nn     \ݒ肷NeuralNetwork
+	* @return d݂̐擪 (dataw) sȃt@C̏ꍇnullptr
+	*/
+	template<typename T>
+	static const T* parse(const char* data, uint64_t size, bool verify, NeuralNetwork<T>& nn)
+	{
+		if (size < sizeof(ModelHeader))
+			return nullptr;
+		ModelHeader header;
+		memcpy(&header, data, sizeof(header));
+		if (header.magic != ModelHeader::MAGIC || header.version < 1 || header.version > ModelHeader::VERSION || header.headerSize != sizeof(ModelHeader))
+			return nullptr;
+		if (header.endian != ModelHeader::ENDIAN || header.weightType != weightType<T>() || header.weightBytes != sizeof(T))
+			return nullptr;
+		if (header.fileSize != size || header.layerNum < 3 || header.weightSize <= 0)
+			return nullptr;
+		if (header.layerOffset != sizeof(ModelHeader) || header.weightOffset % ModelHeader::ALIGNMENT != 0)
+			return nullptr;
+		if (header.weightOffset < header.layerOffset + sizeof(ModelLayer) * header.layerNum)
+			return nullptr;
+		if (header.weightOffset + sizeof(T) * static_cast<uint64_t>(header.weightSize) != size)
+			return nullptr;
+
+		// w̑傫Əd݂̈ʒuĂȂ
+		const ModelLayer* layers = reinterpret_cast<const ModelLayer*>(data + header.layerOffset);
+		auto actFncID = [&header, layers](int i)
+		{
+			// o[W1ł4oCgID
+			if (header.version == 1)
+			{
+				int32_t id = 0;
+				memcpy(&id, &layers[i].actFncID, sizeof(id));
+				return ActFncID(id);
+			}
+			return ActFncID(layers[i].actFncID);
+		};
+		auto precision = [&header, layers](int i)
+		{
+			return header.version == 1 ? ActFncPrecision::EXACT : ActFncPrecision(layers[i].actFncPrecision);
+		};
+
+		int64_t weightSize = 0;
+		for (int i = 0; i < header.layerNum; ++i)
+		{
+			if (layers[i].size <= 0 || (i > 0 && (!ActFncOperator::in(actFncID(i)) || !ActFncOperator::in(precision(i)))))
+				return nullptr;
+			if (i > 0)
+			{
+				if (layers[i].weightIndex != weightSize)
+					return nullptr;
+				weightSize += static_cast<int64_t>(layers[i].size) * (layers[i - 1].size + 1);
+			}
+		}
+		if (weightSize != header.weightSize)
+			return nullptr;
+
+		if (verify)
+		{
+			uint64_t hash = checksum(data + header.layerOffset, header.weightOffset - header.layerOffset);
+			if (checksum(data + header.weightOffset, size - header.weightOffset, hash) != header.checksum)
+				return nullptr;
+		}
+
+		nn.clear();
+		nn.setInputLayer(layers[0].size);
+		nn.setHiddenLayerNum(header.layerNum - 2);
+		for (int i = 1; i < header.layerNum - 1; ++i)
+			nn.setHiddenLayer(layers[i].size, actFncID(i), precision(i));
+		nn.setOutputLayer(layers[header.layerNum - 1].size, actFncID(header.layerNum - 1), precision(header.layerNum - 1));
+
+		return reinterpret_cast<const T*>(data + header.weightOffset);
+	}
+
+	/*
+	* 64bit̃`FbNT߂
+	*
+	* 32oCgS{̓ƗŌvẐŁA傫ȃfł̑шɋ߂ŋ܂
+	*
+	* @param data f[^
+	* @param size oCg
+	* @param seed Ö̗̃`FbNT (ċ߂ꍇ)
+	*/
+	static uint64_t checksum(const void* data, uint64_t size, uint64_t seed = 0)
+	{
+		static constexpr uint64_t PRIME1 = 0x9e3779b185ebca87ull;
+		static constexpr uint64_t PRIME2 = 0xc2b2ae3d27d4eb4full;
+		const unsigned char* p = static_cast<const unsigned char*>(data);
+
+		uint64_t lane[4] = { seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1 };
+		uint64_t i = 0;
+		for (; i + 32 <= size; i += 32)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				uint64_t word;
+				memcpy(&word, p + i + j * 8, sizeof(word));
+				lane[j] = rotl(lane[j] + word * PRIME2, 31) * PRIME1;
+			}
+		}
+
+		uint64_t hash = rotl(lane[0], 1) + rotl(lane[1], 7) + rotl(lane[2], 12) + rotl(lane[3], 18);
+		for (; i + 8 <= size; i += 8)
+		{
+			uint64_t word;
+			memcpy(&word, p + i, sizeof(word));
+			hash = rotl(hash ^ (rotl(word * PRIME2, 31) * PRIME1), 27) * PRIME1 + PRIME2;
+		}
+		for (; i < size; ++i)
+			hash = rotl(hash ^ (p[i] * PRIME1), 11) * PRIME2;
+
+		hash ^= size;
+		hash ^= hash >> 33;
+		hash *= PRIME2;
+		hash ^= hash >> 29;
+		return hash;
+	}
+
+	// @return sizeALIGNMENT̔{ɐ؂グl
+	static constexpr uint64_t align(uint64_t size)
+	{
+		return (size + ModelHeader::ALIGNMENT - 1) / ModelHeader::ALIGNMENT * ModelHeader::ALIGNMENT;
+	}
+
+private:
+	static constexpr uint64_t rotl(uint64_t x, int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+
+private:
+	ModelFile() = delete;
+};
+
+/*
+* template<typename T>
+* T ́EóEď݂^ intEfloatEdouble
+*
+* ft@C}bvAt@C̏d݂Rs[ɂ̂܂܎gNeuralNetwork
+*
+* d݂̓y[WLbVKvɂȂɓǂ܂̂ŁA傫ȃfłɎgn߂
+* setWeight֐덷t`dŏd݂ƁA̎_ŏd݂ɃRs[̂Ńt@C͕ςȂ
+* getNeuralNetwork֐œNeuralNetwork͂̃NX܂łgȂ
+*/
+template<typename T>
+class MappedModel
+{
+public:
+	MappedModel() = default;
+
+	~MappedModel()
+	{
+		close();
+	}
+
+	MappedModel(const MappedModel&) = delete;
+	MappedModel& operator=(const MappedModel&) = delete;
+
+public:
+	/*
+	* ft@C}bv
+	*
+	* @param path   LAFileIO::outputNeuralNetworkModel֐ŏot@C
+	* @param verify truȅꍇchecksum؂ (dݑŜxǂ)
+	* @return }bvłȂꍇsȃt@C̏ꍇfalse
+	*/
+	bool open(const std::string& path, bool verify = true)
+	{
+		close();
+		if (!m_file.open(path))
+			return false;
+
+		const T* weight = ModelFile::parse(m_file.getData(), m_file.getSize(), verify, m_nn);
+		if (weight == nullptr)
+		{
+			close();
+			return false;
+		}
+		m_nn.bindWeight(std::span<const T>(weight, m_nn.getWeightSize()));
+		return true;
+	}
+
+	void close()
+	{
+		m_nn.clear();
+		m_file.close();
+	}
+
+	// @return t@C}bvĂꍇtrue
+	bool isOpen() const
+	{
+		return m_file.getData() != nullptr;
+	}
+
+	// @return d݂t@CwĂNeuralNetwork
+	NeuralNetwork<T>& getNeuralNetwork()
+	{
+		return m_nn;
+	}
+
+	// @return d݂t@CwĂNeuralNetwork
+	const NeuralNetwork<T>& getNeuralNetwork() const
+	{
+		return m_nn;
+	}
+
+private:
+	MappedFile m_file;
+	NeuralNetwork<T> m_nn;
+};
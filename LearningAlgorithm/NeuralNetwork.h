@@ -2,11 +2,16 @@
 
 #include "ActFncOperator.h"
 #include "Random.h"
+#include "SimdKernel.h"
+#include "Telemetry.h"
 #include <memory>
+#include <cstring>
+#include <algorithm>
+#include <span>
 
 /*
 * template<typename T>
-* T ́EóEď݂^ intdouble
+* T ́EóEď݂^ intEfloatEdouble
 * 
 * ̃NX̐܂clear֐Ă񂾏Ԃł
 * ܂@`D̊֐Ɏs邱
@@ -17,7 +22,7 @@
 template<typename T>
 class NeuralNetwork
 {
-	static_assert(std::is_same_v<T, int> || std::is_same_v<T, double>, "NeuralNetwork template is only int or double");
+	static_assert(std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double>, "NeuralNetwork template is only int, float or double");
 
 public:
 	NeuralNetwork();
@@ -59,10 +64,11 @@ public:
 	* ĂԂƂɓ͑wɋ߂珇ɐݒ肷
 	* oCAXm[h
 	* 
-	* @param size   m[h (oCAXm[h܂܂Ȃ)
-	* @param actFnc ֐ID
+	* @param size      m[h (oCAXm[h܂܂Ȃ)
+	* @param actFnc    ֐ID
+	* @param precision ֐̌vZ̐x (SigmoidTanĥ݉e)
 	*/
-	void setHiddenLayer(int size, ActFncID actFncID);
+	void setHiddenLayer(int size, ActFncID actFncID, ActFncPrecision precision = ActFncPrecision::EXACT);
 
 	/*
 	* Co͑w̐ݒ
@@ -70,30 +76,72 @@ public:
 	* oCAXm[hȂ
 	* d݂̃TCY͂ŌvZAd݂
 	*
-	* @param size   m[h
-	* @param actFnc ֐ID
+	* @param size      m[h
+	* @param actFnc    ֐ID
+	* @param precision ֐̌vZ̐x (SigmoidTanĥ݉e)
 	*/
-	void setOutputLayer(int size, ActFncID actFncID);
+	void setOutputLayer(int size, ActFncID actFncID, ActFncPrecision precision = ActFncPrecision::EXACT);
 
 	/*
 	* Dd݂̐ݒ
 	* 
-	* ꂩD'̂ǂ炩Ă
+	* ꂩD'ED''̂ꂩĂ
+	* d݂؂Ăꍇ (bindWeight֐) ́ÃNXmۂɃRs[Ԃɖ߂
 	* 
 	* @param weight d݂̔z TCY = getWeightSize֐
 	*/
 	void setWeight(const T* weight);
 
+	/*
+	* D''Ȍd݂Rs[Ɏ؂
+	* 
+	* ꂩDED'̂ꂩĂ
+	* GǍ (GeneticAlgorithm::getIndividual֐) Rs[ɂ̂܂܏d݂ƂĎg
+	* mۂd݂͉̃ɎcA؂̂߂Ƃɍėp
+	* ؂ĂԁAweight͂̃NX珑Ȃ
+	* (setWeight֐EsetWeightRandom֐E덷t`d́Aɂ̃NXmۂɃRs[Ă珑)
+	* 
+	* ̖
+	*     weightẃAbindWeightEunbindWeightEsetWeightEsetWeightRandomEclear֐ĂԂ
+	*     ̃NXj܂ŗLŁAeςȂ
+	*     GǍ̂؂ꍇAgenerateNextGeneration֐ĂԂƓeς̂ŁAゲƂɎ؂蒼
+	* 
+	* @param weight d݂̔z TCY = getWeightSize֐ȏ
+	* @return weight̃TCYȂꍇfalse (̏ꍇ͉ύXȂ)
+	*/
+	bool bindWeight(std::span<const T> weight);
+
+	/*
+	* ؂Ăd݂̃NXmۂɃRs[A؂̂߂
+	* 
+	* d݂؂ĂȂꍇ͉Ȃ
+	*/
+	void unbindWeight();
+
+	// @return bindWeight֐ŊȌd݂؂Ăꍇtrue
+	bool isWeightBound() const;
+
 	/*
 	* D'd݂_ɐݒ
 	* 
-	* ꂩD̂ǂ炩Ă
+	* ꂩDED''̂ꂩĂ
 	* 
 	* @param min _̍ŏl (܂)
 	* @param max _̍ől (܂)
 	*/
 	void setWeightRandom(T min, T max);
 
+	/*
+	* D'd݂_ɐݒ (w)
+	* 
+	* V[h̗nΓd݂Č
+	* 
+	* @param min    _̍ŏl (܂)
+	* @param max    _̍ől (܂)
+	* @param random 
+	*/
+	void setWeightRandom(T min, T max, Random& random);
+
 	/*
 	* `dē͂o͂𓾂
 	* 
@@ -102,14 +150,91 @@ public:
 	*/
 	const T* forwardPropagation(const T* input);
 
+	/*
+	* ̓͂܂Ƃ߂ď`dďo͂𓾂
+	* 
+	* ͂BATCH_BLOCK̃ubNɕđwƂɍsςƂČvZ
+	* d݂̓ubNɂxǂݍ܂
+	* 
+	* @param input     ͔z TCY = sampleNum * getInputLayerSize֐
+	*     N(0-based)̓ = input[(͑w̃m[h * N) ` ((͑w̃m[h * (N + 1)) - 1)]
+	* @param sampleNum ͂̐
+	* @param output    o͔z TCY = sampleNum * getOutputLayerSize֐
+	*     N(0-based)̏o = output[(o͑w̃m[h * N) ` ((o͑w̃m[h * (N + 1)) - 1)]
+	*/
+	void forwardPropagation(const T* input, int sampleNum, T* output);
+
+	class Workspace;
+
+	/*
+	* `dē͂o͂𓾂 (const)
+	* 
+	* r̒l͑Sworkspaceɏ܂ÃNX̏Ԃ͕ςȂ
+	* workspaceXbhƂɗpӂ΁ÃXbh瓯ɌĂяo
+	* 
+	* @param input     ͔z TCY = getInputLayerSize֐
+	* @param workspace ̃NX̍\ɍ킹ĊmۂꂽƗ̈
+	* @return o͔z (workspacew) TCY = getOutputLayerSize֐
+	*/
+	const T* forwardPropagation(const T* input, Workspace& workspace) const;
+
+	/*
+	* ̓͂܂Ƃ߂ď`dďo͂𓾂 (const)
+	* 
+	* r̒l͑Sworkspaceɏ܂ÃNX̏Ԃ͕ςȂ
+	* workspaceXbhƂɗpӂ΁ÃXbh瓯ɌĂяo
+	* 
+	* @param input     ͔z TCY = sampleNum * getInputLayerSize֐
+	* @param sampleNum ͂̐
+	* @param output    o͔z TCY = sampleNum * getOutputLayerSize֐
+	* @param workspace ̃NX̍\ɍ킹ĊmۂꂽƗ̈
+	*/
+	void forwardPropagation(const T* input, int sampleNum, T* output, Workspace& workspace) const;
+
 	/*
 	* 덷t`dďd݂𒲐
 	* 
+	* Tfloatdoublȅꍇ̂ݎg
+	* 덷͏o͂̓덷1/2Ƃ
+	* 
 	* @param input  `dɂ͔z
 	* @param output ͂ɑ΂Ė]ޏo͔z
 	*/
 	void backpropagation(const T* input, const T* output);
 
+	/*
+	* ~job`Ō덷t`dďd݂𒲐
+	* 
+	* Tfloatdoublȅꍇ̂ݎg
+	* SĂ̓͂̌zvA̕ςŏd݂xXV
+	* Ɨ͇̈CŊmۂ邽߁Å֐̓mۂȂ
+	* 
+	* @param input     `dɂ͔z TCY = sampleNum * getInputLayerSize֐
+	* @param output    ͂ɑ΂Ė]ޏo͔z TCY = sampleNum * getOutputLayerSize֐
+	* @param sampleNum ͂̐ (0ȉ̏ꍇ͉Ȃ)
+	*/
+	void backpropagation(const T* input, const T* output, int sampleNum);
+
+	/*
+	* 덷t`d̊wK̐ݒ
+	* 
+	* @param rate wK (l = 0.1)
+	*/
+	void setLearningRate(double rate);
+
+	/*
+	* `d̎ԂL^̐ݒ
+	* 
+	* LA_TELEMETRY`ăRpCꍇ̂ݓA`Ȃꍇ͉Ȃ
+	* GeneticAlgorithmƓL^ɂƁAゲƂ̏`d̑x
+	* 
+	* @param telemetry L^ (nullptrŋL^Ȃ) ̃NXgI܂ŕێ邱
+	*/
+	void setTelemetry(Telemetry* telemetry);
+
+	// @return 덷t`d̊wK
+	double getLearningRate() const;
+
 	// @return ͑w̃m[h
 	int getInputLayerSize() const;
 
@@ -122,12 +247,18 @@ public:
 	// @return indexԖ(0-based)̒ԑẘ֐
 	ActFncID getHiddenLayerActFncID(int index) const;
 
+	// @return indexԖ(0-based)̒ԑẘ֐̌vZ̐x
+	ActFncPrecision getHiddenLayerActFncPrecision(int index) const;
+
 	// @return o͑w̃m[h
 	int getOutputLayerSize() const;
 
 	// @return o͑ẘ֐
 	ActFncID getOutputLayerActFncID() const;
 
+	// @return o͑ẘ֐̌vZ̐x
+	ActFncPrecision getOutputLayerActFncPrecision() const;
+
 	/*
 	* @`Cݒ肵ď߂ē
 	* 
@@ -138,18 +269,65 @@ public:
 	// @return d݂̔z
 	const T* getWeight() const;
 
+public:
+	// ܂Ƃ߂ď`dۂɈxɌvZ͂̐
+	static constexpr int BATCH_BLOCK = 64;
+
+	/*
+	* `d̍Ɨ̈
+	* 
+	* constłforwardPropagation֐ɓnĎg
+	* d݂Ȃ߁APNeuralNetworkɑ΂ăXbh̐pӂ΂悢
+	* NeuralNetwork̍\ύXꍇreset
+	*/
+	class Workspace
+	{
+	public:
+		Workspace() = default;
+
+		// @param nn C܂Őݒ肵NeuralNetwork
+		explicit Workspace(const NeuralNetwork& nn)
+		{
+			reset(nn);
+		}
+
+		/*
+		* nn̍\ɍ킹čƗ̈mۂ
+		* 
+		* @param nn C܂Őݒ肵NeuralNetwork
+		*/
+		void reset(const NeuralNetwork& nn)
+		{
+			// ł傫wɍ킹
+			int maxLayerSize = std::max(nn.getInputLayerSize(), nn.getOutputLayerSize());
+			for (int i = 0; i < nn.getHiddenLayerNum(); ++i)
+				maxLayerSize = std::max(maxLayerSize, nn.getHiddenLayerSize(i));
+			m_layer[0].reset(new T[BATCH_BLOCK * (maxLayerSize + 1)]);
+			m_layer[1].reset(new T[BATCH_BLOCK * (maxLayerSize + 1)]);
+			m_output.reset(new T[nn.getOutputLayerSize()]);
+		}
+
+	private:
+		friend class NeuralNetwork;
+
+		std::unique_ptr<T[]> m_layer[2];
+		std::unique_ptr<T[]> m_output;
+	};
+
 private:
 	struct Layer
 	{
 		int size = 0;
 		std::unique_ptr<T[]> layer;
-		std::unique_ptr<ActivationFunction<T>> actFnc;
+		ActFncID actFncID = ActFncID::IDENTITY;
+		ActFncPrecision precision = ActFncPrecision::EXACT;
 
 		void clear()
 		{
 			size = 0;
 			layer.reset();
-			actFnc.reset();
+			actFncID = ActFncID::IDENTITY;
+			precision = ActFncPrecision::EXACT;
 		}
 	};
 
@@ -158,7 +336,43 @@ private:
 	std::unique_ptr<Layer[]> m_hiddenLayer;
 	Layer m_outputLayer;
 	int m_weightSize;
-	std::unique_ptr<T[]> m_weight;
+	std::unique_ptr<T[]> m_weightBuffer;
+	const T* m_weight;
+	Workspace m_workspace;
+	double m_learningRate;
+	int m_neuronNum;
+	std::unique_ptr<T[]> m_preActivation;
+	std::unique_ptr<T[]> m_delta;
+	std::unique_ptr<T[]> m_gradient;
+#if defined(LA_TELEMETRY)
+	Telemetry* m_telemetry;
+#endif
+
+	// @return indexԖڂ̑w (0 = ͑wA1`ԑw̐ = ԑwAԑw̐ + 1 = o͑w)
+	Layer& getLayer(int index);
+
+	/*
+	* ȎwsampleNum̎̑w̒lvZ
+	* 
+	* @param src       Ȏw̒l (oCAXm[h܂) TCY = sampleNum * (srcSize + 1)
+	* @param srcSize   Ȏw̃m[h (oCAXm[h܂܂Ȃ)
+	* @param sampleNum ͂̐
+	* @param weight    Ȏw玟̑wւ̏d TCY = dstLayer.size * (srcSize + 1)
+	* @param dstLayer  ̑w
+	* @param dst       ̑w̒l̏ݐ
+	* @param dstStride dstɂ͂P̊Ԋu
+	*/
+	static void propagate(const T* src, int srcSize, int sampleNum, const T* weight, const Layer& dstLayer, T* dst, int dstStride);
+
+	/*
+	* d݂𓾂
+	* 
+	* d݂؂Ăꍇ́ÃNXmۂɐ؂ւ (mۂȂ)
+	* 
+	* @param copy truȅꍇA؂Ăd݂̒lRs[
+	* @return ̃NXmۂd݂̔z
+	*/
+	T* getOwnWeight(bool copy);
 };
 
 
@@ -171,7 +385,17 @@ inline NeuralNetwork<T>::NeuralNetwork()
 	, m_hiddenLayer()
 	, m_outputLayer()
 	, m_weightSize()
+	, m_weightBuffer()
 	, m_weight()
+	, m_workspace()
+	, m_learningRate(0.1)
+	, m_neuronNum()
+	, m_preActivation()
+	, m_delta()
+	, m_gradient()
+#if defined(LA_TELEMETRY)
+	, m_telemetry()
+#endif
 {
 }
 
@@ -188,7 +412,14 @@ inline void NeuralNetwork<T>::clear()
 	m_hiddenLayer.reset();
 	m_outputLayer.clear();
 	m_weightSize = 0;
-	m_weight.reset();
+	m_weightBuffer.reset();
+	m_weight = nullptr;
+	m_workspace = Workspace();
+	m_learningRate = 0.1;
+	m_neuronNum = 0;
+	m_preActivation.reset();
+	m_delta.reset();
+	m_gradient.reset();
 }
 
 template<typename T>
@@ -207,21 +438,23 @@ inline void NeuralNetwork<T>::setHiddenLayerNum(int num)
 }
 
 template<typename T>
-inline void NeuralNetwork<T>::setHiddenLayer(int size, ActFncID actFncID)
+inline void NeuralNetwork<T>::setHiddenLayer(int size, ActFncID actFncID, ActFncPrecision precision)
 {
 	auto& hiddenLayer = m_hiddenLayer[m_hiddenLayerNum++];
 	hiddenLayer.size = size;
 	hiddenLayer.layer.reset(new T[size + 1]);
 	hiddenLayer.layer[size] = 1;
-	hiddenLayer.actFnc.reset(ActFncOperator::create<T>(actFncID));
+	hiddenLayer.actFncID = actFncID;
+	hiddenLayer.precision = precision;
 }
 
 template<typename T>
-inline void NeuralNetwork<T>::setOutputLayer(int size, ActFncID actFncID)
+inline void NeuralNetwork<T>::setOutputLayer(int size, ActFncID actFncID, ActFncPrecision precision)
 {
 	m_outputLayer.size = size;
 	m_outputLayer.layer.reset(new T[size]);
-	m_outputLayer.actFnc.reset(ActFncOperator::create<T>(actFncID));
+	m_outputLayer.actFncID = actFncID;
+	m_outputLayer.precision = precision;
 
 	// ͑wƒԑw̏d݃TCY
 	m_weightSize = (m_inputLayer.size + 1) * m_hiddenLayer[0].size;
@@ -233,73 +466,260 @@ inline void NeuralNetwork<T>::setOutputLayer(int size, ActFncID actFncID)
 	// ԑwƏo͑w̏d݃TCY
 	m_weightSize += (m_hiddenLayer[m_hiddenLayerNum - 1].size + 1) * m_outputLayer.size;
 
-	m_weight.reset(new T[m_weightSize]);
+	m_weightBuffer.reset(new T[m_weightSize]);
+	m_weight = m_weightBuffer.get();
+
+	// constł̏`dŎgƗ̈
+	m_workspace.reset(*this);
+
+	// 덷t`d̍Ɨ̈ (ԑwƏo͑w̑Sm[h)
+	if constexpr (std::is_floating_point_v<T>)
+	{
+		m_neuronNum = m_outputLayer.size;
+		for (int i = 0; i < m_hiddenLayerNum; ++i)
+			m_neuronNum += m_hiddenLayer[i].size;
+		m_preActivation.reset(new T[m_neuronNum]);
+		m_delta.reset(new T[m_neuronNum]);
+		m_gradient.reset(new T[m_weightSize]);
+	}
 }
 
 template<typename T>
 inline void NeuralNetwork<T>::setWeight(const T* weight)
 {
-	memcpy(m_weight.get(), weight, sizeof(T) * m_weightSize);
+	memcpy(getOwnWeight(false), weight, sizeof(T) * m_weightSize);
+}
+
+template<typename T>
+inline bool NeuralNetwork<T>::bindWeight(std::span<const T> weight)
+{
+	if (weight.size() < static_cast<size_t>(m_weightSize))
+		return false;
+
+	m_weight = weight.data();
+	return true;
+}
+
+template<typename T>
+inline void NeuralNetwork<T>::unbindWeight()
+{
+	getOwnWeight(true);
+}
+
+template<typename T>
+inline bool NeuralNetwork<T>::isWeightBound() const
+{
+	return m_weight != m_weightBuffer.get();
 }
 
 template<typename T>
 inline void NeuralNetwork<T>::setWeightRandom(T min, T max)
 {
-	auto random = Random<T>();
-	for (int i = 0; i < m_weightSize; ++i)
-		m_weight[i] = random(min, max);
+	auto random = Random();
+	setWeightRandom(min, max, random);
+}
+
+template<typename T>
+inline void NeuralNetwork<T>::setWeightRandom(T min, T max, Random& random)
+{
+	random.fill(getOwnWeight(false), m_weightSize, min, max);
 }
 
 template<typename T>
 inline const T* NeuralNetwork<T>::forwardPropagation(const T* input)
 {
-	for (int i = 0; i < m_inputLayer.size; ++i)
-		m_inputLayer.layer[i] = input[i];
+	return forwardPropagation(input, m_workspace);
+}
+
+template<typename T>
+inline void NeuralNetwork<T>::forwardPropagation(const T* input, int sampleNum, T* output)
+{
+	forwardPropagation(input, sampleNum, output, m_workspace);
+}
+
+template<typename T>
+inline const T* NeuralNetwork<T>::forwardPropagation(const T* input, Workspace& workspace) const
+{
+	forwardPropagation(input, 1, workspace.m_output.get(), workspace);
+	return workspace.m_output.get();
+}
 
-	int weightIndex = 0;
+template<typename T>
+inline void NeuralNetwork<T>::forwardPropagation(const T* input, int sampleNum, T* output, Workspace& workspace) const
+{
+#if defined(LA_TELEMETRY)
+	TelemetryTimer timer;
+#endif
 
-	// ͑wƒԑw
-	for (int h = 0; h < m_hiddenLayer[0].size; ++h)
+	for (int begin = 0; begin < sampleNum; begin += BATCH_BLOCK)
 	{
-		T sum = 0;
-		for (int i = 0; i < m_inputLayer.size + 1; ++i)
+		int blockNum = std::min(BATCH_BLOCK, sampleNum - begin);
+		T* src = workspace.m_layer[0].get();
+		T* dst = workspace.m_layer[1].get();
+
+		// ͑w (͂ƂɃoCAXm[ht)
+		int srcSize = m_inputLayer.size;
+		for (int s = 0; s < blockNum; ++s)
 		{
-			sum += m_inputLayer.layer[i] * m_weight[weightIndex++];
+			memcpy(&src[s * (srcSize + 1)], &input[(begin + s) * srcSize], sizeof(T) * srcSize);
+			src[s * (srcSize + 1) + srcSize] = 1;
 		}
-		m_hiddenLayer[0].layer[h] = (*m_hiddenLayer[0].actFnc)(sum);
+
+		const T* weight = m_weight;
+
+		// ͑wƒԑwAԑwm
+		for (int n = 0; n < m_hiddenLayerNum; ++n)
+		{
+			const Layer& hiddenLayer = m_hiddenLayer[n];
+			propagate(src, srcSize, blockNum, weight, hiddenLayer, dst, hiddenLayer.size + 1);
+			for (int s = 0; s < blockNum; ++s)
+				dst[s * (hiddenLayer.size + 1) + hiddenLayer.size] = 1;
+
+			weight += hiddenLayer.size * (srcSize + 1);
+			srcSize = hiddenLayer.size;
+			std::swap(src, dst);
+		}
+
+		// ԑwƏo͑w
+		propagate(src, srcSize, blockNum, weight, m_outputLayer, &output[begin * m_outputLayer.size], m_outputLayer.size);
 	}
 
-	// ԑwm
-	for (int n = 0; n < m_hiddenLayerNum - 1; ++n)
+#if defined(LA_TELEMETRY)
+	if (m_telemetry)
+		m_telemetry->recordForward(sampleNum, timer.lap());
+#endif
+}
+
+template<typename T>
+inline void NeuralNetwork<T>::backpropagation(const T* input, const T* output)
+{
+	backpropagation(input, output, 1);
+}
+
+template<typename T>
+inline void NeuralNetwork<T>::backpropagation(const T* input, const T* output, int sampleNum)
+{
+	static_assert(std::is_floating_point_v<T>, "NeuralNetwork::backpropagation is only float or double");
+
+	// z̕ς܂Ȃ (0Ŋ) ̂ŁAd݂؂ĂԂ܂߂ĉςȂ
+	if (sampleNum <= 0)
+		return;
+
+	std::fill(m_gradient.get(), m_gradient.get() + m_weightSize, T(0));
+
+	for (int s = 0; s < sampleNum; ++s)
 	{
-		for (int h2 = 0; h2 < m_hiddenLayer[n + 1].size; ++h2)
+		// `d (֐KpO̒lcĂ)
+		memcpy(m_inputLayer.layer.get(), &input[s * m_inputLayer.size], sizeof(T) * m_inputLayer.size);
+		int weightIndex = 0;
+		int neuronIndex = 0;
+		for (int l = 1; l <= m_hiddenLayerNum + 1; ++l)
 		{
-			T sum = 0;
-			for (int h = 0; h < m_hiddenLayer[n].size + 1; ++h)
+			const Layer& src = getLayer(l - 1);
+			Layer& dst = getLayer(l);
+			T* preActivation = &m_preActivation[neuronIndex];
+			for (int d = 0; d < dst.size; ++d)
+				preActivation[d] = SimdKernel::dot(src.layer.get(), &m_weight[weightIndex + d * (src.size + 1)], src.size + 1);
+			memcpy(dst.layer.get(), preActivation, sizeof(T) * dst.size);
+			ActFncOperator::apply(dst.actFncID, dst.layer.get(), dst.size, dst.precision);
+
+			weightIndex += dst.size * (src.size + 1);
+			neuronIndex += dst.size;
+		}
+
+		// o͑w̌덷
+		neuronIndex -= m_outputLayer.size;
+		T* outputDelta = &m_delta[neuronIndex];
+		ActFncOperator::derivative(m_outputLayer.actFncID, &m_preActivation[neuronIndex], m_outputLayer.layer.get(), outputDelta, m_outputLayer.size);
+		for (int o = 0; o < m_outputLayer.size; ++o)
+			outputDelta[o] *= m_outputLayer.layer[o] - output[s * m_outputLayer.size + o];
+
+		// o͑w͑wɌČ덷`dȂzv
+		for (int l = m_hiddenLayerNum + 1; l >= 1; --l)
+		{
+			const Layer& src = getLayer(l - 1);
+			const Layer& dst = getLayer(l);
+			const int stride = src.size + 1;
+			weightIndex -= dst.size * stride;
+
+			const T* dstDelta = &m_delta[neuronIndex];
+			T* gradient = &m_gradient[weightIndex];
+			for (int d = 0; d < dst.size; ++d)
 			{
-				sum += m_hiddenLayer[n].layer[h] * m_weight[weightIndex++];
+				for (int i = 0; i < stride; ++i)
+					gradient[d * stride + i] += dstDelta[d] * src.layer[i];
+			}
+
+			// ͑w̌덷͕sv
+			if (l == 1)
+				break;
+
+			neuronIndex -= src.size;
+			T* srcDelta = &m_delta[neuronIndex];
+			ActFncOperator::derivative(src.actFncID, &m_preActivation[neuronIndex], src.layer.get(), srcDelta, src.size);
+			for (int i = 0; i < src.size; ++i)
+			{
+				T sum = 0;
+				for (int d = 0; d < dst.size; ++d)
+					sum += m_weight[weightIndex + d * stride + i] * dstDelta[d];
+				srcDelta[i] *= sum;
 			}
-			m_hiddenLayer[n + 1].layer[h2] = (*m_hiddenLayer[n + 1].actFnc)(sum);
 		}
 	}
 
-	// ԑwƏo͑w
-	for (int o = 0; o < m_outputLayer.size; ++o)
+	// z̕ςŏd݂XV
+	T rate = static_cast<T>(m_learningRate / sampleNum);
+	T* weight = getOwnWeight(true);
+	for (int i = 0; i < m_weightSize; ++i)
+		weight[i] -= rate * m_gradient[i];
+}
+
+template<typename T>
+inline void NeuralNetwork<T>::setLearningRate(double rate)
+{
+	m_learningRate = rate;
+}
+
+template<typename T>
+inline void NeuralNetwork<T>::setTelemetry(Telemetry* telemetry)
+{
+#if defined(LA_TELEMETRY)
+	m_telemetry = telemetry;
+#else
+	(void)telemetry;
+#endif
+}
+
+template<typename T>
+inline double NeuralNetwork<T>::getLearningRate() const
+{
+	return m_learningRate;
+}
+
+template<typename T>
+inline void NeuralNetwork<T>::propagate(const T* src, int srcSize, int sampleNum, const T* weight, const Layer& dstLayer, T* dst, int dstStride)
+{
+	// d݂̂Psǂݍ񂾂ubN̑SĂ̓͂Ɏg
+	for (int d = 0; d < dstLayer.size; ++d)
 	{
-		T sum = 0;
-		for (int h = 0; h < m_hiddenLayer[m_hiddenLayerNum - 1].size + 1; ++h)
-		{
-			sum += m_hiddenLayer[m_hiddenLayerNum - 1].layer[h] * m_weight[weightIndex++];
-		}
-		m_outputLayer.layer[o] = (*m_outputLayer.actFnc)(sum);
+		const T* row = &weight[d * (srcSize + 1)];
+		for (int s = 0; s < sampleNum; ++s)
+			dst[s * dstStride + d] = SimdKernel::dot(&src[s * (srcSize + 1)], row, srcSize + 1);
 	}
 
-	return m_outputLayer.layer.get();
+	// ֐͑wPʂł܂Ƃ߂ēKp
+	for (int s = 0; s < sampleNum; ++s)
+		ActFncOperator::apply(dstLayer.actFncID, &dst[s * dstStride], dstLayer.size, dstLayer.precision);
 }
 
 template<typename T>
-inline void NeuralNetwork<T>::backpropagation(const T* input, const T* output)
+inline typename NeuralNetwork<T>::Layer& NeuralNetwork<T>::getLayer(int index)
 {
+	if (index == 0)
+		return m_inputLayer;
+	if (index <= m_hiddenLayerNum)
+		return m_hiddenLayer[index - 1];
+	return m_outputLayer;
 }
 
 template<typename T>
@@ -323,7 +743,13 @@ inline int NeuralNetwork<T>::getHiddenLayerSize(int index) const
 template<typename T>
 inline ActFncID NeuralNetwork<T>::getHiddenLayerActFncID(int index) const
 {
-	return static_cast<ActFncID>(*m_hiddenLayer[index].actFnc);
+	return m_hiddenLayer[index].actFncID;
+}
+
+template<typename T>
+inline ActFncPrecision NeuralNetwork<T>::getHiddenLayerActFncPrecision(int index) const
+{
+	return m_hiddenLayer[index].precision;
 }
 
 template<typename T>
@@ -335,7 +761,13 @@ inline int NeuralNetwork<T>::getOutputLayerSize() const
 template<typename T>
 inline ActFncID NeuralNetwork<T>::getOutputLayerActFncID() const
 {
-	return static_cast<ActFncID>(*m_outputLayer.actFnc);
+	return m_outputLayer.actFncID;
+}
+
+template<typename T>
+inline ActFncPrecision NeuralNetwork<T>::getOutputLayerActFncPrecision() const
+{
+	return m_outputLayer.precision;
 }
 
 template<typename T>
@@ -347,6 +779,18 @@ inline int NeuralNetwork<T>::getWeightSize() const
 template<typename T>
 inline const T* NeuralNetwork<T>::getWeight() const
 {
-	return m_weight.get();
+	return m_weight;
 }
 
+template<typename T>
+inline T* NeuralNetwork<T>::getOwnWeight(bool copy)
+{
+	if (isWeightBound())
+	{
+		// mۂ͎؂ĂԂcĂ̂ŁÂ܂܎g
+		if (copy)
+			memcpy(m_weightBuffer.get(), m_weight, sizeof(T) * m_weightSize);
+		m_weight = m_weightBuffer.get();
+	}
+	return m_weightBuffer.get();
+}
@@ -0,0 +1,293 @@
+#pragma once
+
+#include "NeuralNetwork.h"
+#include <memory>
+#include <algorithm>
+
+/*
+* template<typename T>
+* T ́EóEď݂^ intEfloatEdouble
+* 
+* \NeuralNetwork (GȂS) ܂Ƃ߂ď`dNX
+* 
+* d݂́ud݂̃CfbNX ~ ́v̏ɕבւĕێ
+* ł̃[v̂ɂẴ[vɂ邱ƂSIMD̃[̂ɑΉ
+* 
+* ̃NX̐͂܂@Å֐Ɏs邱
+* Ȃꍇ̑̊֐ĂяoȂ
+*/
+template<typename T>
+class PopulationNeuralNetwork
+{
+	static_assert(std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double>, "PopulationNeuralNetwork template is only int, float or double");
+
+public:
+	PopulationNeuralNetwork();
+	~PopulationNeuralNetwork();
+
+	PopulationNeuralNetwork(const PopulationNeuralNetwork&) = delete;
+	PopulationNeuralNetwork& operator=(const PopulationNeuralNetwork&) = delete;
+
+	PopulationNeuralNetwork(PopulationNeuralNetwork&&) = default;
+	PopulationNeuralNetwork& operator=(PopulationNeuralNetwork&&) = default;
+
+public:
+	/*
+	* @\̐ݒ
+	* 
+	* nn̑w̍\Ɗ֐Rs[ (d݂͎gȂ)
+	* 
+	* @param nn C܂Őݒ肵NeuralNetwork
+	*/
+	void setStructure(const NeuralNetwork<T>& nn);
+
+	/*
+	* AS̂̏d݂̐ݒ
+	* 
+	* オiނƂɌĂђ
+	* 
+	* @param individuals S̂̏d݂̔z TCY = population * getWeightSize֐
+	*     N(0-based)̏d = individuals[(d݂̃TCY * N) ` ((d݂̃TCY * (N + 1)) - 1)]
+	*     GeneticAlgorithm::getIndividuals֐̖߂l̂܂ܓn
+	* @param population  ̐
+	*/
+	void setIndividuals(const T* individuals, int population);
+
+	/*
+	* S̂ɂĕ̓͂܂Ƃ߂ď`dďo͂𓾂
+	* 
+	* @param input     ͔z TCY = sampleNum * getInputLayerSize֐
+	* @param sampleNum ͂̐
+	* @param output    o͔z TCY = getPopulation֐ * sampleNum * getOutputLayerSize֐
+	*     PԖ(0-based)̌̂N(0-based)̓͂ɑ΂o = output[(o͑w̃m[h * (sampleNum * P + N)) ` ((o͑w̃m[h * (sampleNum * P + N + 1)) - 1)]
+	*/
+	void forwardPropagation(const T* input, int sampleNum, T* output);
+
+	/*
+	* `d̎ԂL^̐ݒ
+	* 
+	* LA_TELEMETRY`ăRpCꍇ̂ݓA`Ȃꍇ͉Ȃ
+	* `d͂̐ (̐ * ͂̐) ƂċL^
+	* 
+	* @param telemetry L^ (nullptrŋL^Ȃ) ̃NXgI܂ŕێ邱
+	*/
+	void setTelemetry(Telemetry* telemetry);
+
+	// @return ͑w̃m[h
+	int getInputLayerSize() const;
+
+	// @return o͑w̃m[h
+	int getOutputLayerSize() const;
+
+	// @return d݂̃TCY (P̕)
+	int getWeightSize() const;
+
+	// @return ̐
+	int getPopulation() const;
+
+public:
+	// ̐̔{ɐ؂グĕێ (SIMD̃[)
+	static constexpr int LANE = 16;
+
+private:
+	int m_layerNum;
+	std::unique_ptr<int[]> m_layerSize;
+	std::unique_ptr<ActFncID[]> m_actFncID;
+	std::unique_ptr<ActFncPrecision[]> m_precision;
+	int m_weightSize;
+	int m_population;
+	int m_stride;
+	std::unique_ptr<T[]> m_weight;
+	std::unique_ptr<T[]> m_layer[2];
+#if defined(LA_TELEMETRY)
+	Telemetry* m_telemetry;
+#endif
+};
+
+
+
+
+template<typename T>
+inline PopulationNeuralNetwork<T>::PopulationNeuralNetwork()
+	: m_layerNum()
+	, m_layerSize()
+	, m_actFncID()
+	, m_precision()
+	, m_weightSize()
+	, m_population()
+	, m_stride()
+	, m_weight()
+	, m_layer()
+#if defined(LA_TELEMETRY)
+	, m_telemetry()
+#endif
+{
+}
+
+template<typename T>
+inline PopulationNeuralNetwork<T>::~PopulationNeuralNetwork()
+{
+}
+
+template<typename T>
+inline void PopulationNeuralNetwork<T>::setStructure(const NeuralNetwork<T>& nn)
+{
+	// ͑wAԑwAo͑w̏ɕׂ (͑ẘ֐͎gȂ)
+	m_layerNum = nn.getHiddenLayerNum() + 2;
+	m_layerSize.reset(new int[m_layerNum]);
+	m_actFncID.reset(new ActFncID[m_layerNum]);
+	m_precision.reset(new ActFncPrecision[m_layerNum]);
+	m_layerSize[0] = nn.getInputLayerSize();
+	m_actFncID[0] = ActFncID::IDENTITY;
+	m_precision[0] = ActFncPrecision::EXACT;
+	for (int i = 0; i < nn.getHiddenLayerNum(); ++i)
+	{
+		m_layerSize[i + 1] = nn.getHiddenLayerSize(i);
+		m_actFncID[i + 1] = nn.getHiddenLayerActFncID(i);
+		m_precision[i + 1] = nn.getHiddenLayerActFncPrecision(i);
+	}
+	m_layerSize[m_layerNum - 1] = nn.getOutputLayerSize();
+	m_actFncID[m_layerNum - 1] = nn.getOutputLayerActFncID();
+	m_precision[m_layerNum - 1] = nn.getOutputLayerActFncPrecision();
+	m_weightSize = nn.getWeightSize();
+
+	m_population = 0;
+	m_stride = 0;
+	m_weight.reset();
+	m_layer[0].reset();
+	m_layer[1].reset();
+}
+
+template<typename T>
+inline void PopulationNeuralNetwork<T>::setIndividuals(const T* individuals, int population)
+{
+	// ̐ςꍇ̂݃mۂ
+	int stride = (population + LANE - 1) / LANE * LANE;
+	if (stride != m_stride)
+	{
+		int maxLayerSize = *std::max_element(m_layerSize.get(), m_layerSize.get() + m_layerNum);
+		m_weight.reset(new T[m_weightSize * stride]);
+		m_layer[0].reset(new T[maxLayerSize * stride]);
+		m_layer[1].reset(new T[maxLayerSize * stride]);
+		m_stride = stride;
+	}
+	m_population = population;
+
+	// d݂̃CfbNXƂɑS̂̒lׂ ([̌̂0Ŗ߂)
+	for (int w = 0; w < m_weightSize; ++w)
+	{
+		T* weight = &m_weight[w * m_stride];
+		for (int p = 0; p < population; ++p)
+			weight[p] = individuals[p * m_weightSize + w];
+		for (int p = population; p < m_stride; ++p)
+			weight[p] = 0;
+	}
+}
+
+template<typename T>
+inline void PopulationNeuralNetwork<T>::forwardPropagation(const T* input, int sampleNum, T* output)
+{
+	const int stride = m_stride;
+	const int inputSize = m_layerSize[0];
+	const int outputSize = m_layerSize[m_layerNum - 1];
+
+#if defined(LA_TELEMETRY)
+	TelemetryTimer timer;
+#endif
+
+	for (int s = 0; s < sampleNum; ++s)
+	{
+		const T* sample = &input[s * inputSize];
+		const T* weight = m_weight.get();
+		T* dst = m_layer[0].get();
+
+		// ͑wƂPڂ̒ԑw (͂͑S̂ŋ)
+		for (int d = 0; d < m_layerSize[1]; ++d)
+		{
+			T* sum = &dst[d * stride];
+			const T* bias = &weight[inputSize * stride];
+			for (int p = 0; p < stride; ++p)
+				sum[p] = bias[p];
+			for (int i = 0; i < inputSize; ++i)
+			{
+				const T x = sample[i];
+				const T* w = &weight[i * stride];
+				for (int p = 0; p < stride; ++p)
+					sum[p] += x * w[p];
+			}
+			ActFncOperator::apply(m_actFncID[1], sum, stride, m_precision[1]);
+			weight += (inputSize + 1) * stride;
+		}
+
+		// ԑwmAԑwƏo͑w (̂ƂɒlقȂ)
+		for (int l = 2; l < m_layerNum; ++l)
+		{
+			const T* src = dst;
+			dst = m_layer[(l - 1) % 2].get();
+			const int srcSize = m_layerSize[l - 1];
+			for (int d = 0; d < m_layerSize[l]; ++d)
+			{
+				T* sum = &dst[d * stride];
+				const T* bias = &weight[srcSize * stride];
+				for (int p = 0; p < stride; ++p)
+					sum[p] = bias[p];
+				for (int i = 0; i < srcSize; ++i)
+				{
+					const T* x = &src[i * stride];
+					const T* w = &weight[i * stride];
+					for (int p = 0; p < stride; ++p)
+						sum[p] += x[p] * w[p];
+				}
+				ActFncOperator::apply(m_actFncID[l], sum, stride, m_precision[l]);
+				weight += (srcSize + 1) * stride;
+			}
+		}
+
+		// ̂Ƃ̏o͂ɕג
+		for (int p = 0; p < m_population; ++p)
+		{
+			T* out = &output[(p * sampleNum + s) * outputSize];
+			for (int o = 0; o < outputSize; ++o)
+				out[o] = dst[o * stride + p];
+		}
+	}
+
+#if defined(LA_TELEMETRY)
+	if (m_telemetry)
+		m_telemetry->recordForward(static_cast<int64_t>(m_population) * sampleNum, timer.lap());
+#endif
+}
+
+template<typename T>
+inline void PopulationNeuralNetwork<T>::setTelemetry(Telemetry* telemetry)
+{
+#if defined(LA_TELEMETRY)
+	m_telemetry = telemetry;
+#else
+	(void)telemetry;
+#endif
+}
+
+template<typename T>
+inline int PopulationNeuralNetwork<T>::getInputLayerSize() const
+{
+	return m_layerSize[0];
+}
+
+template<typename T>
+inline int PopulationNeuralNetwork<T>::getOutputLayerSize() const
+{
+	return m_layerSize[m_layerNum - 1];
+}
+
+template<typename T>
+inline int PopulationNeuralNetwork<T>::getWeightSize() const
+{
+	return m_weightSize;
+}
+
+template<typename T>
+inline int PopulationNeuralNetwork<T>::getPopulation() const
+{
+	return m_population;
+}
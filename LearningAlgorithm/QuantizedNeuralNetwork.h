@@ -0,0 +1,384 @@
+#pragma once
+
+#include "NeuralNetwork.h"
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <cstdint>
+
+/*
+* ʎq̐x̔r
+*/
+struct QuantizationReport
+{
+	double maxError = 0;         // o͂̌덷̐Βl̍ő
+	double meanError = 0;        // o͂̌덷̐Βl̕
+	double argmaxAgreement = 0;  // ő̏o͂̃m[hv͂̊ (0`1)
+	int64_t originalBytes = 0;   // NN̏d݂̃oCg
+	int64_t quantizedBytes = 0;  // ʎqd݁EXP[EoCAX̃oCg
+};
+
+/*
+* template<typename Q>
+* Q ʎqd݂Ƒw̒ľ^ int8_tEint16_t
+*
+* wKς݂NeuralNetwork𐮐ɗʎqĐ_sNX
+*
+* d݂͍s (̑w̃m[h) ƂɁAw̒l͑wƂɃXP[AΏ̂ɗʎq
+*     ۂ̒l = ʎql * XP[
+* Ϙaint32ŗݐς (SimdKernel::dotQuantized֐)AoCAXƊ֐floatŌvZ
+*
+* ʎq̍ől͌^͈̔͂ƑȎw̃m[h猈߁Aint32̗ݐςӂȂ悤ɂ
+*
+* ̃NX̐͂܂quantize֐s邱
+* Ȃꍇ̑̊֐ĂяoȂ
+*/
+template<typename Q>
+class QuantizedNeuralNetwork
+{
+	static_assert(std::is_same_v<Q, int8_t> || std::is_same_v<Q, int16_t>, "QuantizedNeuralNetwork template is only int8_t or int16_t");
+
+public:
+	QuantizedNeuralNetwork();
+	~QuantizedNeuralNetwork();
+
+	QuantizedNeuralNetwork(const QuantizedNeuralNetwork&) = delete;
+	QuantizedNeuralNetwork& operator=(const QuantizedNeuralNetwork&) = delete;
+
+	QuantizedNeuralNetwork(QuantizedNeuralNetwork&&) = default;
+	QuantizedNeuralNetwork& operator=(QuantizedNeuralNetwork&&) = default;
+
+public:
+	// ܂Ƃ߂ď`dۂɈxɌvZ͂̐
+	static constexpr int BATCH_BLOCK = 64;
+
+	/*
+	* nnʎq
+	*
+	* ew̒l̃XP[́Ainputnnɏ`dƂ̊ew̒l̐Βl̍ő傩猈߂ (Lu[V)
+	* input͎ۂɐ_͂̕z\̂n
+	*
+	* @param nn        C܂Őݒ肵NeuralNetwork
+	* @param input     Lu[Vp͔̓z TCY = sampleNum * nn.getInputLayerSize֐
+	* @param sampleNum ͂̐ Pȏ
+	*/
+	template<typename T>
+	void quantize(const NeuralNetwork<T>& nn, const T* input, int sampleNum);
+
+	/*
+	* ̓͂܂Ƃ߂ď`dďo͂𓾂
+	*
+	* ͂BATCH_BLOCK̃ubNɕđwƂɌvZ
+	*
+	* @param input     ͔z TCY = sampleNum * getInputLayerSize֐
+	* @param sampleNum ͂̐
+	* @param output    o͔z TCY = sampleNum * getOutputLayerSize֐
+	*/
+	void forwardPropagation(const float* input, int sampleNum, float* output);
+
+	/*
+	* NNƏoׂ͂
+	*
+	* @param nn        ʎq̌ɂȂNeuralNetwork
+	* @param input     ͔z TCY = sampleNum * getInputLayerSize֐
+	* @param sampleNum ͂̐ Pȏ
+	* @return r
+	*/
+	template<typename T>
+	QuantizationReport compare(const NeuralNetwork<T>& nn, const T* input, int sampleNum);
+
+	// @return ͑w̃m[h
+	int getInputLayerSize() const;
+
+	// @return o͑w̃m[h
+	int getOutputLayerSize() const;
+
+	// @return ʎqd݁EXP[EoCAX̃oCg
+	int64_t getByteSize() const;
+
+private:
+	// Ȏw玟̑wւ̗ʎqd
+	struct Layer
+	{
+		int srcSize = 0;
+		int size = 0;
+		ActFncID actFncID = ActFncID::IDENTITY;
+		ActFncPrecision precision = ActFncPrecision::EXACT;
+		float srcScale = 1;                // Ȏw̒l̃XP[
+		Q srcMax = 0;                      // Ȏw̒l̗ʎq̍ől
+		std::unique_ptr<Q[]> weight;       // TCY = size * srcSize (oCAX)
+		std::unique_ptr<float[]> scale;    // Ȏw̒l̃XP[ * sƂ̏d݂̃XP[ TCY = size
+		std::unique_ptr<float[]> bias;     // TCY = size
+	};
+
+	/*
+	* fanIn̐Ϙaint32𒴂Ȃʎq̍ől
+	*
+	* @param fanIn Ϙa̗vf
+	*/
+	static Q getMax(int fanIn);
+
+	// @return xscaleŗʎql
+	static Q quantizeValue(float x, float scale, Q max);
+
+	/*
+	* NN̊ew̒l̐Βl̍ő߂ (֐KpAŌ͏o͑w)
+	*
+	* @return TCY = ԑw̐ + 2 (͑wo͑w܂)
+	*/
+	template<typename T>
+	static std::vector<double> calibrate(const NeuralNetwork<T>& nn, const T* input, int sampleNum);
+
+private:
+	std::vector<Layer> m_layers;
+	int m_inputLayerSize;
+	int m_maxLayerSize;
+	std::unique_ptr<Q[]> m_quantized[2];
+	std::unique_ptr<float[]> m_value;
+};
+
+
+
+
+template<typename Q>
+inline QuantizedNeuralNetwork<Q>::QuantizedNeuralNetwork()
+	: m_layers()
+	, m_inputLayerSize()
+	, m_maxLayerSize()
+	, m_quantized()
+	, m_value()
+{
+}
+
+template<typename Q>
+inline QuantizedNeuralNetwork<Q>::~QuantizedNeuralNetwork()
+{
+}
+
+template<typename Q>
+template<typename T>
+inline void QuantizedNeuralNetwork<Q>::quantize(const NeuralNetwork<T>& nn, const T* input, int sampleNum)
+{
+	const std::vector<double> maxValue = calibrate(nn, input, sampleNum);
+
+	m_layers.clear();
+	m_inputLayerSize = nn.getInputLayerSize();
+	m_maxLayerSize = std::max(nn.getInputLayerSize(), nn.getOutputLayerSize());
+
+	const T* weight = nn.getWeight();
+	int srcSize = nn.getInputLayerSize();
+	for (int n = 0; n <= nn.getHiddenLayerNum(); ++n)
+	{
+		Layer layer;
+		layer.srcSize = srcSize;
+		if (n < nn.getHiddenLayerNum())
+		{
+			layer.size = nn.getHiddenLayerSize(n);
+			layer.actFncID = nn.getHiddenLayerActFncID(n);
+			layer.precision = nn.getHiddenLayerActFncPrecision(n);
+		}
+		else
+		{
+			layer.size = nn.getOutputLayerSize();
+			layer.actFncID = nn.getOutputLayerActFncID();
+			layer.precision = nn.getOutputLayerActFncPrecision();
+		}
+		m_maxLayerSize = std::max(m_maxLayerSize, layer.size);
+
+		const Q max = getMax(srcSize);
+		layer.srcMax = max;
+		layer.srcScale = maxValue[n] > 0 ? static_cast<float>(maxValue[n] / max) : 1.0f;
+		layer.weight.reset(new Q[static_cast<size_t>(layer.size) * srcSize]);
+		layer.scale.reset(new float[layer.size]);
+		layer.bias.reset(new float[layer.size]);
+
+		// sƂɏd݂̐Βl̍ő傪maxɂȂ悤ɃXP[߂
+		for (int d = 0; d < layer.size; ++d)
+		{
+			const T* row = &weight[d * (srcSize + 1)];
+			double rowMax = 0;
+			for (int i = 0; i < srcSize; ++i)
+				rowMax = std::max(rowMax, std::abs(static_cast<double>(row[i])));
+			float rowScale = rowMax > 0 ? static_cast<float>(rowMax / max) : 1.0f;
+
+			for (int i = 0; i < srcSize; ++i)
+				layer.weight[d * srcSize + i] = quantizeValue(static_cast<float>(row[i]), rowScale, max);
+			layer.scale[d] = layer.srcScale * rowScale;
+			layer.bias[d] = static_cast<float>(row[srcSize]);
+		}
+
+		weight += layer.size * (srcSize + 1);
+		srcSize = layer.size;
+		m_layers.push_back(std::move(layer));
+	}
+
+	m_quantized[0].reset(new Q[BATCH_BLOCK * m_maxLayerSize]);
+	m_quantized[1].reset(new Q[BATCH_BLOCK * m_maxLayerSize]);
+	m_value.reset(new float[BATCH_BLOCK * m_maxLayerSize]);
+}
+
+template<typename Q>
+inline void QuantizedNeuralNetwork<Q>::forwardPropagation(const float* input, int sampleNum, float* output)
+{
+	const int outputSize = getOutputLayerSize();
+	for (int begin = 0; begin < sampleNum; begin += BATCH_BLOCK)
+	{
+		int blockNum = std::min(BATCH_BLOCK, sampleNum - begin);
+		Q* src = m_quantized[0].get();
+		Q* dst = m_quantized[1].get();
+
+		// ͑wʎq
+		const Layer& first = m_layers.front();
+		for (int i = 0; i < blockNum * m_inputLayerSize; ++i)
+			src[i] = quantizeValue(input[begin * m_inputLayerSize + i], first.srcScale, first.srcMax);
+
+		for (size_t n = 0; n < m_layers.size(); ++n)
+		{
+			const Layer& layer = m_layers[n];
+			const bool last = n + 1 == m_layers.size();
+			float* value = last ? &output[begin * outputSize] : m_value.get();
+
+			// d݂̂Psǂݍ񂾂ubN̑SĂ̓͂Ɏg
+			for (int d = 0; d < layer.size; ++d)
+			{
+				const Q* row = &layer.weight[d * layer.srcSize];
+				for (int s = 0; s < blockNum; ++s)
+				{
+					int32_t sum = SimdKernel::dotQuantized(&src[s * layer.srcSize], row, layer.srcSize);
+					value[s * layer.size + d] = sum * layer.scale[d] + layer.bias[d];
+				}
+			}
+			ActFncOperator::apply(layer.actFncID, value, blockNum * layer.size, layer.precision);
+
+			// ̑w̃XP[ŗʎq
+			if (!last)
+			{
+				const Layer& next = m_layers[n + 1];
+				for (int i = 0; i < blockNum * layer.size; ++i)
+					dst[i] = quantizeValue(value[i], next.srcScale, next.srcMax);
+				std::swap(src, dst);
+			}
+		}
+	}
+}
+
+template<typename Q>
+template<typename T>
+inline QuantizationReport QuantizedNeuralNetwork<Q>::compare(const NeuralNetwork<T>& nn, const T* input, int sampleNum)
+{
+	const int inputSize = nn.getInputLayerSize();
+	const int outputSize = nn.getOutputLayerSize();
+
+	std::unique_ptr<T[]> expected(new T[static_cast<size_t>(sampleNum) * outputSize]);
+	typename NeuralNetwork<T>::Workspace workspace(nn);
+	nn.forwardPropagation(input, sampleNum, expected.get(), workspace);
+
+	std::unique_ptr<float[]> floatInput(new float[static_cast<size_t>(sampleNum) * inputSize]);
+	std::unique_ptr<float[]> actual(new float[static_cast<size_t>(sampleNum) * outputSize]);
+	for (int i = 0; i < sampleNum * inputSize; ++i)
+		floatInput[i] = static_cast<float>(input[i]);
+	forwardPropagation(floatInput.get(), sampleNum, actual.get());
+
+	QuantizationReport report;
+	int agreement = 0;
+	for (int s = 0; s < sampleNum; ++s)
+	{
+		const T* e = &expected[s * outputSize];
+		const float* a = &actual[s * outputSize];
+		for (int i = 0; i < outputSize; ++i)
+		{
+			double error = std::abs(static_cast<double>(e[i]) - a[i]);
+			report.maxError = std::max(report.maxError, error);
+			report.meanError += error;
+		}
+		if (std::max_element(e, e + outputSize) - e == std::max_element(a, a + outputSize) - a)
+			++agreement;
+	}
+	report.meanError /= static_cast<double>(sampleNum) * outputSize;
+	report.argmaxAgreement = static_cast<double>(agreement) / sampleNum;
+	report.originalBytes = static_cast<int64_t>(sizeof(T)) * nn.getWeightSize();
+	report.quantizedBytes = getByteSize();
+	return report;
+}
+
+template<typename Q>
+inline int QuantizedNeuralNetwork<Q>::getInputLayerSize() const
+{
+	return m_inputLayerSize;
+}
+
+template<typename Q>
+inline int QuantizedNeuralNetwork<Q>::getOutputLayerSize() const
+{
+	return m_layers.back().size;
+}
+
+template<typename Q>
+inline int64_t QuantizedNeuralNetwork<Q>::getByteSize() const
+{
+	int64_t size = 0;
+	for (const Layer& layer : m_layers)
+		size += sizeof(Q) * static_cast<int64_t>(layer.size) * layer.srcSize + sizeof(float) * 2 * layer.size;
+	return size;
+}
+
+template<typename Q>
+inline Q QuantizedNeuralNetwork<Q>::getMax(int fanIn)
+{
+	// fanIn * max^2 <= 2^31 - 1
+	double max = std::floor(std::sqrt(2147483647.0 / std::max(fanIn, 1)));
+	return static_cast<Q>(std::min(max, static_cast<double>(std::numeric_limits<Q>::max())));
+}
+
+template<typename Q>
+inline Q QuantizedNeuralNetwork<Q>::quantizeValue(float x, float scale, Q max)
+{
+	float q = std::nearbyint(x / scale);
+	return static_cast<Q>(std::clamp(q, -static_cast<float>(max), static_cast<float>(max)));
+}
+
+template<typename Q>
+template<typename T>
+inline std::vector<double> QuantizedNeuralNetwork<Q>::calibrate(const NeuralNetwork<T>& nn, const T* input, int sampleNum)
+{
+	const int layerNum = nn.getHiddenLayerNum() + 2;
+	std::vector<double> maxValue(layerNum);
+
+	int maxLayerSize = std::max(nn.getInputLayerSize(), nn.getOutputLayerSize());
+	for (int i = 0; i < nn.getHiddenLayerNum(); ++i)
+		maxLayerSize = std::max(maxLayerSize, nn.getHiddenLayerSize(i));
+	std::vector<T> src(maxLayerSize + 1);
+	std::vector<T> dst(maxLayerSize + 1);
+
+	// NNƓvZāAȓw̒lL^
+	for (int s = 0; s < sampleNum; ++s)
+	{
+		int srcSize = nn.getInputLayerSize();
+		std::copy(&input[s * srcSize], &input[(s + 1) * srcSize], src.begin());
+		src[srcSize] = 1;
+		for (int i = 0; i < srcSize; ++i)
+			maxValue[0] = std::max(maxValue[0], std::abs(static_cast<double>(src[i])));
+
+		const T* weight = nn.getWeight();
+		for (int n = 1; n < layerNum; ++n)
+		{
+			bool output = n == layerNum - 1;
+			int dstSize = output ? nn.getOutputLayerSize() : nn.getHiddenLayerSize(n - 1);
+			ActFncID actFncID = output ? nn.getOutputLayerActFncID() : nn.getHiddenLayerActFncID(n - 1);
+			ActFncPrecision precision = output ? nn.getOutputLayerActFncPrecision() : nn.getHiddenLayerActFncPrecision(n - 1);
+			for (int d = 0; d < dstSize; ++d)
+				dst[d] = SimdKernel::dot(src.data(), &weight[d * (srcSize + 1)], srcSize + 1);
+			ActFncOperator::apply(actFncID, dst.data(), dstSize, precision);
+			for (int d = 0; d < dstSize; ++d)
+				maxValue[n] = std::max(maxValue[n], std::abs(static_cast<double>(dst[d])));
+
+			weight += dstSize * (srcSize + 1);
+			srcSize = dstSize;
+			dst[srcSize] = 1;
+			std::swap(src, dst);
+		}
+	}
+	return maxValue;
+}
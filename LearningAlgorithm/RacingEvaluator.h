@@ -0,0 +1,318 @@
+#pragma once
+
+#include "GeneticAlgorithm.h"
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <limits>
+#include <cstdint>
+
+/*
+* RacingEvaluator̓v
+*
+* reset֐EclearStatistics֐Ăł̗݌v
+*/
+struct RacingStatistics
+{
+	int64_t individualNum = 0;  // ]̂̐
+	int64_t stoppedNum = 0;     // rőł؂̂̐
+	int64_t sampleNum = 0;      // ۂɕ]Tv̐
+	int64_t totalSampleNum = 0; // ł؂ȂΕ]Tv̐
+
+	// @return ]ȂTv̊ 0`1
+	double getSavedRate() const
+	{
+		return totalSampleNum > 0 ? 1.0 - static_cast<double>(sampleNum) / totalSampleNum : 0.0;
+	}
+};
+
+/*
+* template<typename Gene, typename Fitness>
+* Gene    F̂̌^ intEfloatEdouble
+* Fitness Kx̌^ intEfloatEdouble
+*
+* ̃TvœKx߂ƂɁAʂɓȂƕ̂̕]ł؂
+*
+* Tv`NɕĂP̂]Ar܂ł̓Kx
+* ]I̂̒ŏ (c萔) Ԗڂ̓Kx_Ŏc̃TvȂ
+* Kx̓TvƂ̒l (덷Ƀ}CiXt̓AK0ȉ) ̍vƂ邱
+* Γr܂ł̓Kx͍ŏIIȓKx̏ɂȂ̂ŁAʂ̌͕̂KŌ܂ŕ]AmȓKxɂȂ
+*
+* ł؂̂ɂ́Ar܂ł̓KxSTvɈ΂lݒ肷
+* ̒l͑ł؂_̏ʂ̓KxKႢ̂ŁAG[g̂ɂ͑I΂Ȃ
+* (G[g̈ȊO̐ȇIɂ́A̐lg)
+*
+* ̂̓CfbNXɕ]̂ŁAO̐̃G[g (CfbNX0zu) ŐɊ܂A悭ł؂
+* Tv̕тɕ΂肪ꍇ́A炩ߕבւĂ
+*
+* ̃NX̐͂܂reset֐s邱
+*
+* g
+*     RacingEvaluator<int, int> racing;
+*     racing.reset(sampleNum, 64);
+*     while (...)
+*     {
+*         // [begin, end) ̃Tv̓Kx̍vԂ֐őS̂]Aga.evaluate֐܂ŌĂ
+*         racing.evaluate(ga, [&](int index, const int* chromosome, int begin, int end) { return -error(chromosome, begin, end); });
+*         ga.generateNextGeneration();
+*     }
+*
+* ł؂̂̓Kx͐mł͂Ȃ̂ŁAFitnessCacheɂ͐mȌ (isComplete֐true) ǉ邱
+*
+* ̃Xbh瓯ɌĂяoȂ
+*/
+template<typename Gene, typename Fitness>
+class RacingEvaluator
+{
+	static_assert(std::is_same_v<Gene, int> || std::is_same_v<Gene, float> || std::is_same_v<Gene, double>, "RacingEvaluator template is only int, float or double");
+	static_assert(std::is_same_v<Fitness, int> || std::is_same_v<Fitness, float> || std::is_same_v<Fitness, double>, "RacingEvaluator template is only int, float or double");
+
+public:
+	RacingEvaluator();
+	~RacingEvaluator();
+
+	RacingEvaluator(const RacingEvaluator&) = delete;
+	RacingEvaluator& operator=(const RacingEvaluator&) = delete;
+
+	RacingEvaluator(RacingEvaluator&&) = default;
+	RacingEvaluator& operator=(RacingEvaluator&&) = default;
+
+public:
+	/*
+	* Tvƃ`N̑傫ݒ肵Av0ɖ߂
+	*
+	* @param sampleNum Tv̐ Pȏ
+	* @param chunkSize Pɕ]Tv̐ Pȏ (قǑł؂邪AĂяỏ񐔂)
+	*/
+	void reset(int sampleNum, int chunkSize);
+
+	// v0ɖ߂
+	void clearStatistics();
+
+	/*
+	* mȓKx߂ʂ̌̐̐ݒ
+	*
+	* @param num ̐ (0GÃG[g̐ (PȂP) g l = 0)
+	*/
+	void setSurvivorNum(int num);
+
+	/*
+	* gȃS̂̓Kx߂ (ga.evaluate֐͌Ă΂Ȃ)
+	*
+	* @param ga        ]GeneticAlgorithm
+	* @param fitnesses Kx̏ݐ TCY = l
+	* @param function  Tv̓Kx̍v߂֐ Fitness function(int index, const Gene* chromosome, int begin, int end)
+	*     [begin, end) ̃Tv̓Kx̍vԂ TvƂ̓Kx0ȉł邱
+	* @return reset֐sĂȂꍇfalse (̏ꍇ͉܂Ȃ)
+	*/
+	template<typename Function>
+	bool race(const GeneticAlgorithm<Gene, Fitness>& ga, Fitness* fitnesses, Function function);
+
+	/*
+	* gȃS̂̓Kx߁Aga.evaluate֐Ă
+	*
+	* @param ga       ]GeneticAlgorithm
+	* @param function race֐Ɠ
+	* @return reset֐sĂȂꍇfalse (̏ꍇga.evaluate֐Ă΂Ȃ)
+	*/
+	template<typename Function>
+	bool evaluate(GeneticAlgorithm<Gene, Fitness>& ga, Function function);
+
+	/*
+	* @param index ̂̃CfbNX
+	* @return Orace֐Eevaluate֐őSTv] (Kxm) ꍇtrue
+	*/
+	bool isComplete(int index) const;
+
+	// @return mȓKx߂ʂ̌̐ (0GÃG[g̐)
+	int getSurvivorNum() const;
+
+	// @return Tv̐
+	int getSampleNum() const;
+
+	// @return Pɕ]Tv̐
+	int getChunkSize() const;
+
+	// @return v
+	RacingStatistics getStatistics() const;
+
+private:
+	/*
+	* ł؂̂̓Kx
+	*
+	* @param fitness   r܂ł̓Kx (0)
+	* @param processed ]Tv̐
+	* @return STvɈ΂Kx (fitnessȉ)
+	*/
+	Fitness getConservativeFitness(Fitness fitness, int processed) const;
+
+private:
+	int m_sampleNum;
+	int m_chunkSize;
+	int m_survivorNum;
+	std::vector<char> m_complete;
+	std::vector<Fitness> m_best; // ]I̂̏ʂ̓Kx (擪łႢŏq[v)
+	std::unique_ptr<Fitness[]> m_fitnesses;
+	int m_fitnessesSize;
+	RacingStatistics m_statistics;
+};
+
+
+
+
+template<typename Gene, typename Fitness>
+inline RacingEvaluator<Gene, Fitness>::RacingEvaluator()
+	: m_sampleNum()
+	, m_chunkSize()
+	, m_survivorNum()
+	, m_complete()
+	, m_best()
+	, m_fitnesses()
+	, m_fitnessesSize()
+	, m_statistics()
+{
+}
+
+template<typename Gene, typename Fitness>
+inline RacingEvaluator<Gene, Fitness>::~RacingEvaluator()
+{
+}
+
+template<typename Gene, typename Fitness>
+inline void RacingEvaluator<Gene, Fitness>::reset(int sampleNum, int chunkSize)
+{
+	m_sampleNum = std::max(sampleNum, 1);
+	m_chunkSize = std::max(chunkSize, 1);
+	m_statistics = RacingStatistics();
+}
+
+template<typename Gene, typename Fitness>
+inline void RacingEvaluator<Gene, Fitness>::clearStatistics()
+{
+	m_statistics = RacingStatistics();
+}
+
+template<typename Gene, typename Fitness>
+inline void RacingEvaluator<Gene, Fitness>::setSurvivorNum(int num)
+{
+	m_survivorNum = std::max(num, 0);
+}
+
+template<typename Gene, typename Fitness>
+template<typename Function>
+inline bool RacingEvaluator<Gene, Fitness>::race(const GeneticAlgorithm<Gene, Fitness>& ga, Fitness* fitnesses, Function function)
+{
+	// Tv̐Ȃ̂ŁAS̂̓Kx0ɂȂĂ܂
+	if (m_sampleNum == 0)
+		return false;
+
+	const int population = ga.getPopulation();
+	const size_t survivorNum = static_cast<size_t>(std::min(m_survivorNum > 0 ? m_survivorNum : std::max(ga.getEliteNum(), 1), population));
+	m_complete.assign(population, 0);
+	m_best.clear();
+
+	for (int i = 0; i < population; ++i)
+	{
+		const Gene* chromosome = ga.getIndividual(i);
+		Fitness fitness = 0;
+		int processed = 0;
+		bool stopped = false;
+		while (processed < m_sampleNum)
+		{
+			const int end = std::min(processed + m_chunkSize, m_sampleNum);
+			fitness += function(i, chromosome, processed, end);
+			processed = end;
+
+			// c̃TvœKx͏オȂ̂ŁAʂ̍ŉʂႯΏʂɓȂ
+			if (processed < m_sampleNum && m_best.size() == survivorNum && fitness < m_best.front())
+			{
+				stopped = true;
+				break;
+			}
+		}
+
+		++m_statistics.individualNum;
+		m_statistics.sampleNum += processed;
+		m_statistics.totalSampleNum += m_sampleNum;
+		if (stopped)
+		{
+			fitnesses[i] = getConservativeFitness(fitness, processed);
+			++m_statistics.stoppedNum;
+			continue;
+		}
+
+		fitnesses[i] = fitness;
+		m_complete[i] = 1;
+		if (m_best.size() < survivorNum)
+		{
+			m_best.push_back(fitness);
+			std::push_heap(m_best.begin(), m_best.end(), std::greater<Fitness>());
+		}
+		else if (fitness > m_best.front())
+		{
+			std::pop_heap(m_best.begin(), m_best.end(), std::greater<Fitness>());
+			m_best.back() = fitness;
+			std::push_heap(m_best.begin(), m_best.end(), std::greater<Fitness>());
+		}
+	}
+	return true;
+}
+
+template<typename Gene, typename Fitness>
+template<typename Function>
+inline bool RacingEvaluator<Gene, Fitness>::evaluate(GeneticAlgorithm<Gene, Fitness>& ga, Function function)
+{
+	if (m_fitnessesSize != ga.getPopulation())
+	{
+		m_fitnesses.reset(new Fitness[ga.getPopulation()]);
+		m_fitnessesSize = ga.getPopulation();
+	}
+
+	if (!race(ga, m_fitnesses.get(), function))
+		return false;
+	ga.evaluate(m_fitnesses.get());
+	return true;
+}
+
+template<typename Gene, typename Fitness>
+inline bool RacingEvaluator<Gene, Fitness>::isComplete(int index) const
+{
+	return index < static_cast<int>(m_complete.size()) && m_complete[index] != 0;
+}
+
+template<typename Gene, typename Fitness>
+inline int RacingEvaluator<Gene, Fitness>::getSurvivorNum() const
+{
+	return m_survivorNum;
+}
+
+template<typename Gene, typename Fitness>
+inline int RacingEvaluator<Gene, Fitness>::getSampleNum() const
+{
+	return m_sampleNum;
+}
+
+template<typename Gene, typename Fitness>
+inline int RacingEvaluator<Gene, Fitness>::getChunkSize() const
+{
+	return m_chunkSize;
+}
+
+template<typename Gene, typename Fitness>
+inline RacingStatistics RacingEvaluator<Gene, Fitness>::getStatistics() const
+{
+	return m_statistics;
+}
+
+template<typename Gene, typename Fitness>
+inline Fitness RacingEvaluator<Gene, Fitness>::getConservativeFitness(Fitness fitness, int processed) const
+{
+	// ]Tv̕ςc̃TvłƂ݂Ȃ (͐؂̂ĂČ̒lȉɂ)
+	const double extended = static_cast<double>(fitness) * m_sampleNum / processed;
+	if constexpr (std::is_integral_v<Fitness>)
+		return static_cast<Fitness>(std::max(std::floor(extended), static_cast<double>(std::numeric_limits<Fitness>::lowest())));
+	else
+		return std::min(static_cast<Fitness>(extended), fitness);
+}
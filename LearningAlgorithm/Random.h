@@ -1,24 +1,221 @@
 #pragma once
 
 #include <random>
+#include <cstdint>
+#include <type_traits>
+#include <algorithm>
+#include <cmath>
 
-template<typename T>
+/*
+* NX (xoshiro256**)
+* 
+* V[hƃXg[ԍ͏ɓ񂪓
+* Xg[ԍςƁAV[h݂ɓƗ񂪓
+* (XbhƁE̂Ƃɕʂ̃Xg[gƂŌʂČł)
+* 
+* std::shuffle̕WCu̗GWƂĂg
+*/
 class Random
 {
 public:
+	using result_type = uint64_t;
+
+	//  (ۑEp)
+	struct State
+	{
+		uint64_t s[4];
+	};
+
+public:
+	// V[hstd::random_device瓾
 	Random()
-		: m_engine(std::random_device()())
 	{
+		std::random_device device;
+		seed((static_cast<uint64_t>(device()) << 32) | device());
+	}
+
+	/*
+	* @param seed   V[h
+	* @param stream Xg[ԍ
+	*/
+	explicit Random(uint64_t seed, uint64_t stream = 0)
+	{
+		this->seed(seed, stream);
 	}
 
+	/*
+	* V[hݒ肵
+	* 
+	* @param seed   V[h
+	* @param stream Xg[ԍ
+	*/
+	void seed(uint64_t seed, uint64_t stream = 0)
+	{
+		// V[hƃXg[ԍĂSplitMix64ŏԂ𖄂߂
+		uint64_t x = mix(seed) ^ mix(stream + 0x632be59bd9b4e019ull);
+		for (auto& s : m_state.s)
+			s = splitMix(x);
+	}
+
+	// @return 64bit̗
+	uint64_t operator()()
+	{
+		uint64_t* s = m_state.s;
+		uint64_t result = rotl(s[1] * 5, 7) * 9;
+		uint64_t t = s[1] << 17;
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+		s[2] ^= t;
+		s[3] = rotl(s[3], 45);
+		return result;
+	}
+
+	/*
+	* ͈͂w肵l
+	* 
+	* @param min ŏl (܂)
+	* @param max ől (͊܂ށA͊܂܂Ȃ)
+	* @return minȏmaxȉ (max) ̗
+	*/
+	template<typename T>
 	T operator()(T min, T max)
 	{
-		if constexpr (std::is_same_v<T, int>)
-			return std::uniform_int_distribution<>(min, max)(m_engine);
+		if constexpr (std::is_integral_v<T>)
+			return static_cast<T>(min + static_cast<int64_t>(bounded(static_cast<uint32_t>(static_cast<int64_t>(max) - min + 1))));
+		else if constexpr (std::is_same_v<T, float>)
+			return std::min(min + canonicalFloat() * (max - min), std::nextafter(max, min));
 		else
-			return std::uniform_real_distribution<>(min, max)(m_engine);
+			return min + static_cast<T>(canonical() * (max - min));
+	}
+
+	// @return 0ȏ1̎̈l
+	double canonical()
+	{
+		return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+	}
+
+	// @return 0ȏ1̎̈l (float̐x)
+	float canonicalFloat()
+	{
+		return static_cast<float>((*this)() >> 40) * 0x1.0p-24f;
+	}
+
+	/*
+	* zlŖ߂
+	* 
+	* @param dst ݐ̔z TCY = n
+	* @param n   vf
+	* @param min ŏl (܂)
+	* @param max ől (͊܂ށA͊܂܂Ȃ)
+	*/
+	template<typename T>
+	void fill(T* dst, int n, T min, T max)
+	{
+		for (int i = 0; i < n; ++i)
+			dst[i] = (*this)(min, max);
+	}
+
+	/*
+	* z0ȏ1̎̈lŖ߂
+	* 
+	* @param dst ݐ̔z TCY = n
+	* @param n   vf
+	*/
+	void fillCanonical(double* dst, int n)
+	{
+		for (int i = 0; i < n; ++i)
+			dst[i] = canonical();
+	}
+
+	/*
+	* 2^128񕪗i߂
+	* 
+	* ĂԂтɌ݂ɏdȂȂ񂪓
+	*/
+	void jump()
+	{
+		static constexpr uint64_t JUMP[] = { 0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull };
+
+		State next = {};
+		for (uint64_t jump : JUMP)
+		{
+			for (int b = 0; b < 64; ++b)
+			{
+				if (jump & (1ull << b))
+				{
+					for (int i = 0; i < 4; ++i)
+						next.s[i] ^= m_state.s[i];
+				}
+				(*this)();
+			}
+		}
+		m_state = next;
+	}
+
+	// @return 
+	State getState() const
+	{
+		return m_state;
+	}
+
+	// @param state getState֐œ
+	void setState(const State& state)
+	{
+		m_state = state;
+	}
+
+	static constexpr uint64_t min()
+	{
+		return 0;
+	}
+
+	static constexpr uint64_t max()
+	{
+		return UINT64_MAX;
+	}
+
+private:
+	static uint64_t rotl(uint64_t x, int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+
+	static uint64_t mix(uint64_t z)
+	{
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+		return z ^ (z >> 31);
+	}
+
+	static uint64_t splitMix(uint64_t& x)
+	{
+		x += 0x9e3779b97f4a7c15ull;
+		return mix(x);
+	}
+
+	// @return 0ȏrange̕΂̂Ȃ (range = 0  2^32 Ƃ݂Ȃ)
+	uint32_t bounded(uint32_t range)
+	{
+		if (range == 0)
+			return static_cast<uint32_t>((*this)() >> 32);
+
+		// Lemire̕@ (ZƁA܂Ɋp)
+		uint64_t m = ((*this)() >> 32) * range;
+		uint32_t low = static_cast<uint32_t>(m);
+		if (low < range)
+		{
+			uint32_t threshold = (0u - range) % range;
+			while (low < threshold)
+			{
+				m = ((*this)() >> 32) * range;
+				low = static_cast<uint32_t>(m);
+			}
+		}
+		return static_cast<uint32_t>(m >> 32);
 	}
 
 private:
-	std::mt19937 m_engine;
+	State m_state;
 };
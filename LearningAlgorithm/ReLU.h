@@ -8,10 +8,42 @@ class ReLU : public ActivationFunction<T>
 public:
 	T operator()(T x) const override
 	{
-		return x >= 0 ? x : 0;
+		return compute(x);
 	}
 	explicit operator ActFncID() const noexcept override
 	{
 		return ActFncID::RELU;
 	}
+
+	// z֐ȂvZ
+	static T compute(T x)
+	{
+		return x >= 0 ? x : 0;
+	}
+
+	/*
+	* z̑SvfɓKp
+	* 
+	* @param x z (㏑)
+	* @param n vf
+	*/
+	static void apply(T* x, int n)
+	{
+		for (int i = 0; i < n; ++i)
+			x[i] = compute(x[i]);
+	}
+
+	/*
+	* z̑SvfɂĔl߂
+	* 
+	* @param x ֐KpO̒l̔z
+	* @param y ֐Kp̒l̔z
+	* @param d l̏ݐ
+	* @param n vf
+	*/
+	static void derivative(const T* x, const T*, T* d, int n)
+	{
+		for (int i = 0; i < n; ++i)
+			d[i] = x[i] >= 0 ? 1 : 0;
+	}
 };
@@ -0,0 +1,270 @@
+#pragma once
+
+#include "Random.h"
+#include <memory>
+#include <algorithm>
+
+enum class SelectionID
+{
+	ROULETTE,
+	ALIAS,
+	TOURNAMENT,
+	RANK
+};
+
+/*
+* template<typename Fitness>
+* Fitness Kx̌^ intEfloatEdouble
+* 
+* ̐eINX
+* 
+* ROULETTE   [bgI (ݐϘa̓񕪒T O(log n))
+* ALIAS      [bgI (GCAX@ O(1))
+* TOURNAMENT g[igI (O(g[igTCY))
+* RANK       LOI (ʂɔႵmAݐϘa̓񕪒T O(log n))
+* 
+* ゲƂprepare֐PĂłAselect֐Kvȉ񐔂Ă
+* Ɨ̈͌␔ꍇ̂݊mۂ
+*/
+template<typename Fitness>
+class Selection
+{
+	static_assert(std::is_same_v<Fitness, int> || std::is_same_v<Fitness, float> || std::is_same_v<Fitness, double>, "Selection template is only int, float or double");
+
+public:
+	Selection();
+	~Selection();
+
+	Selection(const Selection&) = delete;
+	Selection& operator=(const Selection&) = delete;
+
+	Selection(Selection&&) = default;
+	Selection& operator=(Selection&&) = default;
+
+public:
+	/*
+	* I@̐ݒ
+	* 
+	* @param id             I@ID (l = ROULETTE)
+	* @param tournamentSize g[igIłPɔׂ̐ (Qȏ)
+	*/
+	void setMethod(SelectionID id, int tournamentSize = 2);
+
+	/*
+	* Ȉ
+	* 
+	* [bgIł͊ȅd݂ (Kx - minFitness + 1) Ƃ
+	* 
+	* @param fitnesses    S̂̓Kx̔z
+	* @param candidates   ěƂȂ̂̃CfbNX̔z
+	* @param candidateNum ě̐ Pȏ
+	* @param minFitness   S̂̓Kx̍ŏl
+	*/
+	void prepare(const Fitness* fitnesses, const int* candidates, int candidateNum, Fitness minFitness);
+
+	/*
+	* @param random 
+	* @return I΂ꂽ̂̃CfbNX (prepare֐candidateŝꂩ)
+	*/
+	int select(Random& random) const;
+
+	// @return I@ID
+	SelectionID getMethod() const;
+
+	// @return g[igIłPɔׂ̐
+	int getTournamentSize() const;
+
+private:
+	void reserve(int candidateNum);
+	void prepareAlias();
+
+private:
+	SelectionID m_id;
+	int m_tournamentSize;
+	const Fitness* m_fitnesses;
+	const int* m_candidates;
+	int m_candidateNum;
+	int m_capacity;
+	std::unique_ptr<Fitness[]> m_prefixSum;
+	std::unique_ptr<double[]> m_probability;
+	std::unique_ptr<int[]> m_alias;
+	std::unique_ptr<int[]> m_work;
+};
+
+
+
+
+template<typename Fitness>
+inline Selection<Fitness>::Selection()
+	: m_id(SelectionID::ROULETTE)
+	, m_tournamentSize(2)
+	, m_fitnesses()
+	, m_candidates()
+	, m_candidateNum()
+	, m_capacity()
+	, m_prefixSum()
+	, m_probability()
+	, m_alias()
+	, m_work()
+{
+}
+
+template<typename Fitness>
+inline Selection<Fitness>::~Selection()
+{
+}
+
+template<typename Fitness>
+inline void Selection<Fitness>::setMethod(SelectionID id, int tournamentSize)
+{
+	m_id = id;
+	m_tournamentSize = tournamentSize;
+}
+
+template<typename Fitness>
+inline void Selection<Fitness>::prepare(const Fitness* fitnesses, const int* candidates, int candidateNum, Fitness minFitness)
+{
+	reserve(candidateNum);
+	m_fitnesses = fitnesses;
+	m_candidates = candidates;
+	m_candidateNum = candidateNum;
+
+	Fitness fitnessBase = (-minFitness) + 1;
+	switch (m_id)
+	{
+	case SelectionID::ROULETTE:
+	case SelectionID::ALIAS:
+	{
+		// d݂̗ݐϘa
+		Fitness sum = 0;
+		for (int i = 0; i < candidateNum; ++i)
+		{
+			sum += fitnesses[candidates[i]] + fitnessBase;
+			m_prefixSum[i] = sum;
+		}
+		if (m_id == SelectionID::ALIAS)
+			prepareAlias();
+		break;
+	}
+	case SelectionID::RANK:
+	{
+		// Kx傫ɕׁAʂ̏d (␔ - ) ̗ݐϘa߂
+		for (int i = 0; i < candidateNum; ++i)
+			m_work[i] = candidates[i];
+		std::sort(m_work.get(), m_work.get() + candidateNum, [fitnesses](int lhs, int rhs)
+			{ return fitnesses[lhs] > fitnesses[rhs]; }
+		);
+		m_candidates = m_work.get();
+
+		Fitness sum = 0;
+		for (int i = 0; i < candidateNum; ++i)
+		{
+			sum += candidateNum - i;
+			m_prefixSum[i] = sum;
+		}
+		break;
+	}
+	case SelectionID::TOURNAMENT:
+		break;
+	}
+}
+
+template<typename Fitness>
+inline int Selection<Fitness>::select(Random& random) const
+{
+	switch (m_id)
+	{
+	case SelectionID::ROULETTE:
+	case SelectionID::RANK:
+	{
+		// ݐϘarȏɂȂŏ̌
+		Fitness r = random(Fitness(0), m_prefixSum[m_candidateNum - 1]);
+		int k = static_cast<int>(std::lower_bound(m_prefixSum.get(), m_prefixSum.get() + m_candidateNum, r) - m_prefixSum.get());
+		return m_candidates[std::min(k, m_candidateNum - 1)];
+	}
+	case SelectionID::ALIAS:
+	{
+		int k = random(0, m_candidateNum - 1);
+		return m_candidates[random.canonical() < m_probability[k] ? k : m_alias[k]];
+	}
+	case SelectionID::TOURNAMENT:
+	{
+		int best = m_candidates[random(0, m_candidateNum - 1)];
+		for (int i = 1; i < m_tournamentSize; ++i)
+		{
+			int challenger = m_candidates[random(0, m_candidateNum - 1)];
+			if (m_fitnesses[challenger] > m_fitnesses[best])
+				best = challenger;
+		}
+		return best;
+	}
+	}
+	throw;
+}
+
+template<typename Fitness>
+inline SelectionID Selection<Fitness>::getMethod() const
+{
+	return m_id;
+}
+
+template<typename Fitness>
+inline int Selection<Fitness>::getTournamentSize() const
+{
+	return m_tournamentSize;
+}
+
+template<typename Fitness>
+inline void Selection<Fitness>::reserve(int candidateNum)
+{
+	if (candidateNum <= m_capacity)
+		return;
+
+	m_prefixSum.reset(new Fitness[candidateNum]);
+	m_probability.reset(new double[candidateNum]);
+	m_alias.reset(new int[candidateNum]);
+	m_work.reset(new int[candidateNum * 2]);
+	m_capacity = candidateNum;
+}
+
+template<typename Fitness>
+inline void Selection<Fitness>::prepareAlias()
+{
+	// Vose ̃GCAX@
+	// ς1ɂȂ悤ɏd݂𐳋KA1̗̕s1ȏ̗񂩂疄߂
+	const int n = m_candidateNum;
+	const double scale = static_cast<double>(n) / static_cast<double>(m_prefixSum[n - 1]);
+	int* small = m_work.get();
+	int* large = m_work.get() + n;
+	int smallNum = 0;
+	int largeNum = 0;
+	for (int i = 0; i < n; ++i)
+	{
+		Fitness weight = m_prefixSum[i] - (i == 0 ? 0 : m_prefixSum[i - 1]);
+		m_probability[i] = static_cast<double>(weight) * scale;
+		m_alias[i] = i;
+		if (m_probability[i] < 1.0)
+			small[smallNum++] = i;
+		else
+			large[largeNum++] = i;
+	}
+
+	while (smallNum > 0 && largeNum > 0)
+	{
+		int s = small[--smallNum];
+		int l = large[largeNum - 1];
+		m_alias[s] = l;
+		m_probability[l] -= 1.0 - m_probability[s];
+		if (m_probability[l] < 1.0)
+		{
+			--largeNum;
+			small[smallNum++] = l;
+		}
+	}
+
+	// ۂߌ덷Ŏc͊m1Ƃ
+	for (int i = 0; i < smallNum; ++i)
+		m_probability[small[i]] = 1.0;
+	for (int i = 0; i < largeNum; ++i)
+		m_probability[large[i]] = 1.0;
+}
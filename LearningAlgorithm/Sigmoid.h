@@ -1,17 +1,74 @@
 #pragma once
 
 #include "ActivationFunction.h"
+#include "FastMath.h"
 #include <cmath>
+#include <type_traits>
 
-class Sigmoid : public ActivationFunction<double>
+template <typename T>
+class Sigmoid : public ActivationFunction<T>
 {
+	static_assert(std::is_floating_point_v<T>, "Sigmoid template is only float or double");
+
 public:
-	double operator()(double x) const override
+	T operator()(T x) const override
 	{
-		return 1.0 / (1.0 + exp(x));
+		return compute(x);
 	}
 	explicit operator ActFncID() const noexcept override
 	{
 		return ActFncID::SIGMOID;
 	}
+
+	// z֐ȂvZ
+	static T compute(T x)
+	{
+		return T(1) / (T(1) + std::exp(x));
+	}
+
+	/*
+	* z̑SvfɓKp
+	* 
+	* ߎꍇ 1 / (1 + exp(x)) = (1 - tanh(x / 2)) / 2 Ƃtanhߎ
+	* 
+	* @param x         z (㏑)
+	* @param n         vf
+	* @param precision vZ̐x
+	*/
+	static void apply(T* x, int n, ActFncPrecision precision = ActFncPrecision::EXACT)
+	{
+		switch (precision)
+		{
+		case ActFncPrecision::APPROXIMATE:
+			for (int i = 0; i < n; ++i)
+				x[i] = T(0.5) - T(0.5) * FastMath::tanhApproximate(x[i] * T(0.5));
+			return;
+		case ActFncPrecision::TABLE:
+		{
+			const T* table = FastMath::getTanhTable<T>();
+			for (int i = 0; i < n; ++i)
+				x[i] = T(0.5) - T(0.5) * FastMath::tanhTable(x[i] * T(0.5), table);
+			return;
+		}
+		default:
+			for (int i = 0; i < n; ++i)
+				x[i] = compute(x[i]);
+			return;
+		}
+	}
+
+	/*
+	* z̑SvfɂĔl߂
+	* 
+	* @param x ֐KpO̒l̔z
+	* @param y ֐Kp̒l̔z
+	* @param d l̏ݐ
+	* @param n vf
+	*/
+	static void derivative(const T*, const T* y, T* d, int n)
+	{
+		// 1 / (1 + exp(x)) ̔ -y * (1 - y)
+		for (int i = 0; i < n; ++i)
+			d[i] = -y[i] * (T(1) - y[i]);
+	}
 };
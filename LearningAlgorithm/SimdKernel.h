@@ -0,0 +1,416 @@
+#pragma once
+
+#include <type_traits>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define LA_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clangł͖߃ZbgƂɊ֐PʂŃR[h (MSVC͎wsv)
+#if defined(__GNUC__)
+#define LA_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define LA_SIMD_TARGET(isa)
+#endif
+
+enum class SimdLevel
+{
+	SCALAR,
+	AVX2,
+	AVX512
+};
+
+/*
+* xNgZ̃J[l
+* 
+* sCPUΉ閽߃Zbg𔻒肵AłĂяo
+* Ή閽߃ZbgȂꍇ̓XJ[g
+*/
+class SimdKernel
+{
+public:
+	// @return sCPUŎg閽߃Zbg
+	static SimdLevel getLevel()
+	{
+		static const SimdLevel level = detect();
+		return level;
+	}
+
+	/*
+	* 
+	* 
+	* @param a z TCY = n
+	* @param b z TCY = n
+	* @param n vf
+	* @return a[0] * b[0] + a[1] * b[1] + ... + a[n - 1] * b[n - 1]
+	*/
+	template<typename T>
+	static T dot(const T* a, const T* b, int n)
+	{
+		static_assert(std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double>, "SimdKernel::dot template is only int, float or double");
+
+		using DotFunction = T(*)(const T*, const T*, int);
+		static const DotFunction function = selectDot<T>();
+		return function(a, b, n);
+	}
+
+	/*
+	* ʎq̓ (int32ŗݐς)
+	* 
+	* ݐςint32𒴂Ȃ͈͂Ŏg
+	* AVX-512 VNNIɑΉĂvpdpwssdŁAAVX2łvpmaddwd16bit̐ϘavZ
+	* 
+	* @param a z TCY = n
+	* @param b z TCY = n
+	* @param n vf
+	* @return a[0] * b[0] + a[1] * b[1] + ... + a[n - 1] * b[n - 1]
+	*/
+	template<typename Q>
+	static int32_t dotQuantized(const Q* a, const Q* b, int n)
+	{
+		static_assert(std::is_same_v<Q, int8_t> || std::is_same_v<Q, int16_t>, "SimdKernel::dotQuantized template is only int8_t or int16_t");
+
+		using DotFunction = int32_t(*)(const Q*, const Q*, int);
+		static const DotFunction function = selectDotQuantized<Q>();
+		return function(a, b, n);
+	}
+
+	// @return AVX-512 VNNI (BW) ɑΉĂꍇtrue
+	static bool hasVnni()
+	{
+		static const bool vnni = detectVnni();
+		return vnni;
+	}
+
+private:
+	static SimdLevel detect()
+	{
+#if defined(LA_SIMD_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4] = {};
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return SimdLevel::SCALAR;
+
+		// OSAVX̃WX^ޔɑΉĂ邩
+		__cpuid(info, 1);
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+		if (!osxsave || !avx)
+			return SimdLevel::SCALAR;
+		unsigned long long xcr0 = _xgetbv(0);
+		if ((xcr0 & 0x6) != 0x6)
+			return SimdLevel::SCALAR;
+
+		__cpuidex(info, 7, 0);
+		bool avx2 = (info[1] & (1 << 5)) != 0;
+		bool avx512f = (info[1] & (1 << 16)) != 0;
+		if (avx512f && (xcr0 & 0xe6) == 0xe6)
+			return SimdLevel::AVX512;
+		if (avx2)
+			return SimdLevel::AVX2;
+#else
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512f"))
+			return SimdLevel::AVX512;
+		if (__builtin_cpu_supports("avx2"))
+			return SimdLevel::AVX2;
+#endif
+#endif
+		return SimdLevel::SCALAR;
+	}
+
+	static bool detectVnni()
+	{
+#if defined(LA_SIMD_X86)
+		if (getLevel() != SimdLevel::AVX512)
+			return false;
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4] = {};
+		__cpuidex(info, 7, 0);
+		bool avx512bw = (info[1] & (1 << 30)) != 0;
+		bool avx512vnni = (info[2] & (1 << 11)) != 0;
+		return avx512bw && avx512vnni;
+#else
+		return __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vnni");
+#endif
+#else
+		return false;
+#endif
+	}
+
+	template<typename Q>
+	static auto selectDotQuantized() -> int32_t(*)(const Q*, const Q*, int)
+	{
+#if defined(LA_SIMD_X86)
+		if (hasVnni())
+			return dotVnni<Q>;
+		if (getLevel() != SimdLevel::SCALAR)
+			return dotAvx2Quantized<Q>;
+#endif
+		return dotScalarQuantized<Q>;
+	}
+
+	template<typename Q>
+	static int32_t dotScalarQuantized(const Q* a, const Q* b, int n)
+	{
+		int32_t sum = 0;
+		for (int i = 0; i < n; ++i)
+			sum += static_cast<int32_t>(a[i]) * b[i];
+		return sum;
+	}
+
+	template<typename T>
+	static auto selectDot() -> T(*)(const T*, const T*, int)
+	{
+#if defined(LA_SIMD_X86)
+		switch (getLevel())
+		{
+		case SimdLevel::AVX512:
+			if constexpr (std::is_same_v<T, int>)
+				return dotAvx512Int;
+			else if constexpr (std::is_same_v<T, float>)
+				return dotAvx512Float;
+			else
+				return dotAvx512Double;
+		case SimdLevel::AVX2:
+			if constexpr (std::is_same_v<T, int>)
+				return dotAvx2Int;
+			else if constexpr (std::is_same_v<T, float>)
+				return dotAvx2Float;
+			else
+				return dotAvx2Double;
+		default:
+			break;
+		}
+#endif
+		return dotScalar<T>;
+	}
+
+	template<typename T>
+	static T dotScalar(const T* a, const T* b, int n)
+	{
+		T sum = 0;
+		for (int i = 0; i < n; ++i)
+			sum += a[i] * b[i];
+		return sum;
+	}
+
+#if defined(LA_SIMD_X86)
+	LA_SIMD_TARGET("avx2")
+	static double dotAvx2Double(const double* a, const double* b, int n)
+	{
+		__m256d sum0 = _mm256_setzero_pd();
+		__m256d sum1 = _mm256_setzero_pd();
+		int i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			sum0 = _mm256_add_pd(sum0, _mm256_mul_pd(_mm256_loadu_pd(&a[i]), _mm256_loadu_pd(&b[i])));
+			sum1 = _mm256_add_pd(sum1, _mm256_mul_pd(_mm256_loadu_pd(&a[i + 4]), _mm256_loadu_pd(&b[i + 4])));
+		}
+		for (; i + 4 <= n; i += 4)
+			sum0 = _mm256_add_pd(sum0, _mm256_mul_pd(_mm256_loadu_pd(&a[i]), _mm256_loadu_pd(&b[i])));
+
+		sum0 = _mm256_add_pd(sum0, sum1);
+		__m128d half = _mm_add_pd(_mm256_castpd256_pd128(sum0), _mm256_extractf128_pd(sum0, 1));
+		double sum = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+		for (; i < n; ++i)
+			sum += a[i] * b[i];
+		return sum;
+	}
+
+	LA_SIMD_TARGET("avx2")
+	static float dotAvx2Float(const float* a, const float* b, int n)
+	{
+		__m256 sum0 = _mm256_setzero_ps();
+		__m256 sum1 = _mm256_setzero_ps();
+		int i = 0;
+		for (; i + 16 <= n; i += 16)
+		{
+			sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(&a[i]), _mm256_loadu_ps(&b[i])));
+			sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(_mm256_loadu_ps(&a[i + 8]), _mm256_loadu_ps(&b[i + 8])));
+		}
+		for (; i + 8 <= n; i += 8)
+			sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(&a[i]), _mm256_loadu_ps(&b[i])));
+
+		sum0 = _mm256_add_ps(sum0, sum1);
+		__m128 half = _mm_add_ps(_mm256_castps256_ps128(sum0), _mm256_extractf128_ps(sum0, 1));
+		half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+		float sum = _mm_cvtss_f32(_mm_add_ss(half, _mm_movehdup_ps(half)));
+		for (; i < n; ++i)
+			sum += a[i] * b[i];
+		return sum;
+	}
+
+	// 16vfint16ɍLēǂݍ
+	template<typename Q>
+	LA_SIMD_TARGET("avx2")
+	static __m256i loadAvx2Int16(const Q* p)
+	{
+		if constexpr (std::is_same_v<Q, int8_t>)
+			return _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+		else
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+	}
+
+	template<typename Q>
+	LA_SIMD_TARGET("avx2")
+	static int32_t dotAvx2Quantized(const Q* a, const Q* b, int n)
+	{
+		__m256i sum0 = _mm256_setzero_si256();
+		int i = 0;
+		for (; i + 16 <= n; i += 16)
+			sum0 = _mm256_add_epi32(sum0, _mm256_madd_epi16(loadAvx2Int16(&a[i]), loadAvx2Int16(&b[i])));
+
+		__m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum0), _mm256_extracti128_si256(sum0, 1));
+		half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+		half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+		int32_t sum = _mm_cvtsi128_si32(half);
+		for (; i < n; ++i)
+			sum += static_cast<int32_t>(a[i]) * b[i];
+		return sum;
+	}
+
+	LA_SIMD_TARGET("avx2")
+	static int dotAvx2Int(const int* a, const int* b, int n)
+	{
+		__m256i sum0 = _mm256_setzero_si256();
+		int i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			__m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&a[i]));
+			__m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b[i]));
+			sum0 = _mm256_add_epi32(sum0, _mm256_mullo_epi32(va, vb));
+		}
+
+		__m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum0), _mm256_extracti128_si256(sum0, 1));
+		half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+		half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+		int sum = _mm_cvtsi128_si32(half);
+		for (; i < n; ++i)
+			sum += a[i] * b[i];
+		return sum;
+	}
+
+	/*
+	* 512bit̑Svf̍v
+	*
+	* _mm512_reduce_addn_mm512_castnE_mm512_extractnGCC 12Œg`̒lg
+	* -WallŖ̌xo ̂߃}XNt̎o (c0) 256bitE128bitɕđ
+	*/
+	LA_SIMD_TARGET("avx512f")
+	static double reduceAvx512(__m512d v)
+	{
+		__m256d quarter = _mm256_add_pd(_mm512_maskz_extractf64x4_pd(0xf, v, 0), _mm512_maskz_extractf64x4_pd(0xf, v, 1));
+		__m128d half = _mm_add_pd(_mm256_castpd256_pd128(quarter), _mm256_extractf128_pd(quarter, 1));
+		return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+	}
+
+	LA_SIMD_TARGET("avx512f")
+	static float reduceAvx512(__m512 v)
+	{
+		__m512d d = _mm512_castps_pd(v);
+		__m256 quarter = _mm256_add_ps(_mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xf, d, 0)), _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xf, d, 1)));
+		__m128 half = _mm_add_ps(_mm256_castps256_ps128(quarter), _mm256_extractf128_ps(quarter, 1));
+		half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+		return _mm_cvtss_f32(_mm_add_ss(half, _mm_movehdup_ps(half)));
+	}
+
+	LA_SIMD_TARGET("avx512f")
+	static int reduceAvx512(__m512i v)
+	{
+		__m256i quarter = _mm256_add_epi32(_mm512_maskz_extracti64x4_epi64(0xf, v, 0), _mm512_maskz_extracti64x4_epi64(0xf, v, 1));
+		__m128i half = _mm_add_epi32(_mm256_castsi256_si128(quarter), _mm256_extracti128_si256(quarter, 1));
+		half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+		half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtsi128_si32(half);
+	}
+
+	LA_SIMD_TARGET("avx512f")
+	static double dotAvx512Double(const double* a, const double* b, int n)
+	{
+		__m512d sum0 = _mm512_setzero_pd();
+		int i = 0;
+		for (; i + 8 <= n; i += 8)
+			sum0 = _mm512_add_pd(sum0, _mm512_mul_pd(_mm512_loadu_pd(&a[i]), _mm512_loadu_pd(&b[i])));
+
+		// [̓}XNtœǂݍ
+		if (i < n)
+		{
+			__mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1);
+			sum0 = _mm512_add_pd(sum0, _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, &a[i]), _mm512_maskz_loadu_pd(mask, &b[i])));
+		}
+		return reduceAvx512(sum0);
+	}
+
+	LA_SIMD_TARGET("avx512f")
+	static float dotAvx512Float(const float* a, const float* b, int n)
+	{
+		__m512 sum0 = _mm512_setzero_ps();
+		int i = 0;
+		for (; i + 16 <= n; i += 16)
+			sum0 = _mm512_add_ps(sum0, _mm512_mul_ps(_mm512_loadu_ps(&a[i]), _mm512_loadu_ps(&b[i])));
+
+		// [̓}XNtœǂݍ
+		if (i < n)
+		{
+			__mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1);
+			sum0 = _mm512_add_ps(sum0, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, &a[i]), _mm512_maskz_loadu_ps(mask, &b[i])));
+		}
+		return reduceAvx512(sum0);
+	}
+
+	LA_SIMD_TARGET("avx512f")
+	static int dotAvx512Int(const int* a, const int* b, int n)
+	{
+		__m512i sum0 = _mm512_setzero_si512();
+		int i = 0;
+		for (; i + 16 <= n; i += 16)
+			sum0 = _mm512_add_epi32(sum0, _mm512_mullo_epi32(_mm512_loadu_si512(&a[i]), _mm512_loadu_si512(&b[i])));
+
+		// [̓}XNtœǂݍ
+		if (i < n)
+		{
+			__mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1);
+			sum0 = _mm512_add_epi32(sum0, _mm512_mullo_epi32(_mm512_maskz_loadu_epi32(mask, &a[i]), _mm512_maskz_loadu_epi32(mask, &b[i])));
+		}
+		return reduceAvx512(sum0);
+	}
+	// 32vfint16ɍLēǂݍ ([̓}XN0ɂ)
+	template<typename Q>
+	LA_SIMD_TARGET("avx512f,avx512bw")
+	static __m512i loadAvx512Int16(const Q* p, __mmask32 mask)
+	{
+		if constexpr (std::is_same_v<Q, int8_t>)
+			return _mm512_cvtepi8_epi16(_mm512_maskz_extracti64x4_epi64(0xf, _mm512_maskz_loadu_epi8(static_cast<__mmask64>(mask), p), 0));
+		else
+			return _mm512_maskz_loadu_epi16(mask, p);
+	}
+
+	template<typename Q>
+	LA_SIMD_TARGET("avx512f,avx512bw,avx512vnni")
+	static int32_t dotVnni(const Q* a, const Q* b, int n)
+	{
+		__m512i sum0 = _mm512_setzero_si512();
+		int i = 0;
+		for (; i + 32 <= n; i += 32)
+			sum0 = _mm512_dpwssd_epi32(sum0, loadAvx512Int16(&a[i], ~__mmask32(0)), loadAvx512Int16(&b[i], ~__mmask32(0)));
+
+		// [̓}XNtœǂݍ
+		if (i < n)
+		{
+			__mmask32 mask = static_cast<__mmask32>((1ull << (n - i)) - 1);
+			sum0 = _mm512_dpwssd_epi32(sum0, loadAvx512Int16(&a[i], mask), loadAvx512Int16(&b[i], mask));
+		}
+		return reduceAvx512(sum0);
+	}
+#endif
+
+private:
+	SimdKernel() = delete;
+};
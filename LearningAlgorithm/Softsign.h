@@ -0,0 +1,59 @@
+#pragma once
+
+#include "ActivationFunction.h"
+#include <cmath>
+#include <type_traits>
+
+template <typename T>
+class Softsign : public ActivationFunction<T>
+{
+	static_assert(std::is_floating_point_v<T>, "Softsign template is only float or double");
+
+public:
+	T operator()(T x) const override
+	{
+		return compute(x);
+	}
+	explicit operator ActFncID() const noexcept override
+	{
+		return ActFncID::SOFTSIGN;
+	}
+
+	// z֐ȂvZ
+	static T compute(T x)
+	{
+		return x / (T(1) + std::abs(x));
+	}
+
+	/*
+	* z̑SvfɓKp
+	* 
+	* expg킸\ɑ̂ŁAxɂ炸vZ
+	* 
+	* @param x z (㏑)
+	* @param n vf
+	*/
+	static void apply(T* x, int n)
+	{
+		for (int i = 0; i < n; ++i)
+			x[i] = compute(x[i]);
+	}
+
+	/*
+	* z̑SvfɂĔl߂
+	* 
+	* @param x ֐KpO̒l̔z
+	* @param y ֐Kp̒l̔z
+	* @param d l̏ݐ
+	* @param n vf
+	*/
+	static void derivative(const T* x, const T*, T* d, int n)
+	{
+		// x / (1 + |x|) ̔ 1 / (1 + |x|)^2
+		for (int i = 0; i < n; ++i)
+		{
+			T a = T(1) + std::abs(x[i]);
+			d[i] = T(1) / (a * a);
+		}
+	}
+};
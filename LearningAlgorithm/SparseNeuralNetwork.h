@@ -0,0 +1,521 @@
+#pragma once
+
+#include "NeuralNetwork.h"
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+// aȏd݂̊i[`
+enum class SparseFormat
+{
+	CSR,   // s (̑w̃m[h) Ƃ0łȂd݂Ƃׂ̗
+	BLOCK  // sƂ0łȂd݂܂BLOCK_SIZẼubNׂ (ubN0i[)
+	       // 0łȂd݂ɂ܂Ƃ܂ĂꍇɌA΂΂̏ꍇCSR̕
+};
+
+/*
+* aȏd݂̂Pw (Ȏw玟̑wւ̏d)
+*
+* sd̏d݂ index[rowBegin[d]] ` index[rowBegin[d + 1] - 1] ̗vf
+*     CSR   : vfk͗index[k]̏dvalue[k]
+*     BLOCK : vfk͗index[k] + c (0 <= c < BLOCK_SIZE) ̏dvalue[k * BLOCK_SIZE + c]
+*             Ȏw̃m[h𒴂̏d݂0
+*/
+template<typename T>
+struct SparseLayer
+{
+	int srcSize = 0;                                   // Ȏw̃m[h (oCAXm[h܂܂Ȃ)
+	int size = 0;                                      // ̑w̃m[h
+	ActFncID actFncID = ActFncID::IDENTITY;
+	ActFncPrecision precision = ActFncPrecision::EXACT;
+	std::vector<int32_t> rowBegin;                     // TCY = size + 1
+	std::vector<int32_t> index;                        // vfƂ̗ (BLOCK̓ubN̐擪̗)
+	std::vector<T> value;                              // TCY = index.size() (BLOCK * BLOCK_SIZE)
+	std::vector<T> bias;                               // TCY = size
+};
+
+/*
+* template<typename T>
+* T ́EóEď݂^ intEfloatEdouble
+*
+* wKς݂NeuralNetwork̐Βl̏d݂0ɂ (})A
+* 0łȂd݂i[Đ_sNX
+*
+* `dBATCH_BLOCK̓͂w̒l͂ƂɘA悤ɕבւČvZA
+* 0łȂd݂PɂubN̑SĂ̓͂̐Ϙa܂Ƃ߂čs (0̏d݂͓ǂݍ݂Ȃ)
+* 啔̏d݂0NNł́AƐ_̎Ԃ0̊ɉČ
+*
+* ̃NX̐͂܂prune֐setLayers֐s邱
+* Ȃꍇ̑̊֐ĂяoȂ
+*/
+template<typename T>
+class SparseNeuralNetwork
+{
+	static_assert(std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double>, "SparseNeuralNetwork template is only int, float or double");
+
+public:
+	SparseNeuralNetwork();
+	~SparseNeuralNetwork();
+
+	SparseNeuralNetwork(const SparseNeuralNetwork&) = delete;
+	SparseNeuralNetwork& operator=(const SparseNeuralNetwork&) = delete;
+
+	SparseNeuralNetwork(SparseNeuralNetwork&&) = default;
+	SparseNeuralNetwork& operator=(SparseNeuralNetwork&&) = default;
+
+public:
+	// ܂Ƃ߂ď`dۂɈxɌvZ͂̐
+	static constexpr int BATCH_BLOCK = 64;
+
+	// SparseFormat::BLOCK̃ubN̗
+	static constexpr int BLOCK_SIZE = 8;
+
+	/*
+	* nn}肵đaȌ`ɕϊ
+	*
+	* Βlthresholdȉ̏d݂0ƂĊi[Ȃ (oCAX͑SĎc)
+	* BLOCK̏ꍇ́Athreshold𒴂d݂Pł܂ރubNi[AubNthresholdȉ̏d݂0ɂ
+	* ̂߂ǂ̌`ł`ďʂ͓ɂȂ
+	*
+	* @param nn        D܂Őݒ肵NeuralNetwork
+	* @param threshold }肷d݂̐Βl̏ (܂)
+	* @param format    i[`
+	*/
+	void prune(const NeuralNetwork<T>& nn, double threshold, SparseFormat format = SparseFormat::CSR);
+
+	/*
+	* w𒼐ڐݒ肷 (LAFileIO::inputSparseNeuralNetwork֐Ŏg)
+	*
+	* @param inputLayerSize ͑w̃m[h
+	* @param format         i[`
+	* @param layers         ͑wɋ߂珇ɕׂw (Ōオo͑w)
+	* @return w̑傫EYĂꍇfalse (̏ꍇ͉ύXȂ)
+	*/
+	bool setLayers(int inputLayerSize, SparseFormat format, std::vector<SparseLayer<T>> layers);
+
+	/*
+	* `dē͂o͂𓾂
+	*
+	* @param input ͔z TCY = getInputLayerSize֐
+	* @return o͔z TCY = getOutputLayerSize֐
+	*/
+	const T* forwardPropagation(const T* input);
+
+	/*
+	* ̓͂܂Ƃ߂ď`dďo͂𓾂
+	*
+	* @param input     ͔z TCY = sampleNum * getInputLayerSize֐
+	* @param sampleNum ͂̐
+	* @param output    o͔z TCY = sampleNum * getOutputLayerSize֐
+	*/
+	void forwardPropagation(const T* input, int sampleNum, T* output);
+
+	/*
+	* }肵d݂𖧂NeuralNetworkɖ߂ (}肵d݂0)
+	*
+	* LAFileIO::outputNeuralNetwork֐ŏoAGAŊwK𑱂肷ꍇɎg
+	*
+	* @param nn ݐ (܂ł̏Ԃ͔j)
+	*/
+	void toNeuralNetwork(NeuralNetwork<T>& nn) const;
+
+	/*
+	* nn̏d݂̐Βl̂Asparsity̏d݂ȉɂȂl
+	*
+	* prune֐thresholdɓnƁA悻sparsitẙ̏d݂}肳 (oCAX)
+	*
+	* @param nn       D܂Őݒ肵NeuralNetwork
+	* @param sparsity }肷銄 0`1
+	*/
+	static double getPruneThreshold(const NeuralNetwork<T>& nn, double sparsity);
+
+	// @return ͑w̃m[h
+	int getInputLayerSize() const;
+
+	// @return o͑w̃m[h
+	int getOutputLayerSize() const;
+
+	// @return i[`
+	SparseFormat getFormat() const;
+
+	// @return w̐ (ԑw̐ + 1)
+	int getLayerNum() const;
+
+	/*
+	* @param index ͑wɋ߂琔ԍ 0 ` getLayerNum֐ - 1
+	* @return w
+	*/
+	const SparseLayer<T>& getLayer(int index) const;
+
+	// @return i[Ăd݂̐ (BLOCK̓ubN0܂݁AoCAX܂܂Ȃ)
+	int64_t getStoredWeightNum() const;
+
+	// @return ̖ȏd݂̐ (oCAX܂܂Ȃ)
+	int64_t getDenseWeightNum() const;
+
+	// @return d݁EYEoCAX̃oCg
+	int64_t getByteSize() const;
+
+private:
+	/*
+	* Pw̏`d
+	*
+	* srcEdst͑w̒l͂ƂɘA悤ɕׂ (m[hi̓s̒l = src[i * blockNum + s])
+	*/
+	void propagate(const SparseLayer<T>& layer, const T* src, int blockNum, T* dst) const;
+
+	// @return sizeBLOCK_SIZE̔{ɐ؂グl
+	static int roundUp(int size);
+
+private:
+	std::vector<SparseLayer<T>> m_layers;
+	SparseFormat m_format;
+	int m_inputLayerSize;
+	int m_maxLayerSize;
+	std::unique_ptr<T[]> m_layer[2];
+	std::unique_ptr<T[]> m_output;
+};
+
+
+
+
+template<typename T>
+inline SparseNeuralNetwork<T>::SparseNeuralNetwork()
+	: m_layers()
+	, m_format(SparseFormat::CSR)
+	, m_inputLayerSize()
+	, m_maxLayerSize()
+	, m_layer()
+	, m_output()
+{
+}
+
+template<typename T>
+inline SparseNeuralNetwork<T>::~SparseNeuralNetwork()
+{
+}
+
+template<typename T>
+inline void SparseNeuralNetwork<T>::prune(const NeuralNetwork<T>& nn, double threshold, SparseFormat format)
+{
+	std::vector<SparseLayer<T>> layers;
+
+	const T* weight = nn.getWeight();
+	int srcSize = nn.getInputLayerSize();
+	for (int n = 0; n <= nn.getHiddenLayerNum(); ++n)
+	{
+		SparseLayer<T> layer;
+		layer.srcSize = srcSize;
+		if (n < nn.getHiddenLayerNum())
+		{
+			layer.size = nn.getHiddenLayerSize(n);
+			layer.actFncID = nn.getHiddenLayerActFncID(n);
+			layer.precision = nn.getHiddenLayerActFncPrecision(n);
+		}
+		else
+		{
+			layer.size = nn.getOutputLayerSize();
+			layer.actFncID = nn.getOutputLayerActFncID();
+			layer.precision = nn.getOutputLayerActFncPrecision();
+		}
+
+		auto kept = [threshold](T w) { return std::abs(static_cast<double>(w)) > threshold; };
+
+		layer.rowBegin.push_back(0);
+		for (int d = 0; d < layer.size; ++d)
+		{
+			const T* row = &weight[d * (srcSize + 1)];
+			if (format == SparseFormat::CSR)
+			{
+				for (int i = 0; i < srcSize; ++i)
+				{
+					if (kept(row[i]))
+					{
+						layer.index.push_back(i);
+						layer.value.push_back(row[i]);
+					}
+				}
+			}
+			else
+			{
+				for (int i = 0; i < srcSize; i += BLOCK_SIZE)
+				{
+					const int end = std::min(i + BLOCK_SIZE, srcSize);
+					if (std::none_of(&row[i], &row[end], kept))
+						continue;
+
+					layer.index.push_back(i);
+					for (int c = i; c < i + BLOCK_SIZE; ++c)
+						layer.value.push_back(c < end && kept(row[c]) ? row[c] : T(0));
+				}
+			}
+			layer.rowBegin.push_back(static_cast<int32_t>(layer.index.size()));
+			layer.bias.push_back(row[srcSize]);
+		}
+
+		weight += layer.size * (srcSize + 1);
+		srcSize = layer.size;
+		layers.push_back(std::move(layer));
+	}
+
+	setLayers(nn.getInputLayerSize(), format, std::move(layers));
+}
+
+template<typename T>
+inline bool SparseNeuralNetwork<T>::setLayers(int inputLayerSize, SparseFormat format, std::vector<SparseLayer<T>> layers)
+{
+	if (inputLayerSize <= 0 || layers.empty() || (format != SparseFormat::CSR && format != SparseFormat::BLOCK))
+		return false;
+
+	const size_t width = format == SparseFormat::BLOCK ? BLOCK_SIZE : 1;
+	int srcSize = inputLayerSize;
+	int maxLayerSize = inputLayerSize;
+	for (const SparseLayer<T>& layer : layers)
+	{
+		if (layer.srcSize != srcSize || layer.size <= 0 || !ActFncOperator::in(layer.actFncID) || !ActFncOperator::in(layer.precision))
+			return false;
+		if (layer.rowBegin.size() != static_cast<size_t>(layer.size) + 1 || layer.bias.size() != static_cast<size_t>(layer.size))
+			return false;
+		if (layer.rowBegin.front() != 0 || layer.rowBegin.back() != static_cast<int64_t>(layer.index.size()) || layer.value.size() != layer.index.size() * width)
+			return false;
+		if (!std::is_sorted(layer.rowBegin.begin(), layer.rowBegin.end()))
+			return false;
+		for (int32_t column : layer.index)
+		{
+			if (column < 0 || column >= srcSize || column % width != 0)
+				return false;
+		}
+
+		srcSize = layer.size;
+		maxLayerSize = std::max(maxLayerSize, layer.size);
+	}
+
+	m_layers = std::move(layers);
+	m_format = format;
+	m_inputLayerSize = inputLayerSize;
+	m_maxLayerSize = roundUp(maxLayerSize);
+
+	// BLOCKł͍Ō̃ubNȎw̃m[h𒴂ǂނ̂ŁA̒̕l0ɂĂ
+	m_layer[0].reset(new T[static_cast<size_t>(BATCH_BLOCK) * m_maxLayerSize]());
+	m_layer[1].reset(new T[static_cast<size_t>(BATCH_BLOCK) * m_maxLayerSize]());
+	m_output.reset(new T[getOutputLayerSize()]);
+
+	return true;
+}
+
+template<typename T>
+inline const T* SparseNeuralNetwork<T>::forwardPropagation(const T* input)
+{
+	forwardPropagation(input, 1, m_output.get());
+	return m_output.get();
+}
+
+template<typename T>
+inline void SparseNeuralNetwork<T>::forwardPropagation(const T* input, int sampleNum, T* output)
+{
+	const int outputSize = getOutputLayerSize();
+	for (int begin = 0; begin < sampleNum; begin += BATCH_BLOCK)
+	{
+		int blockNum = std::min(BATCH_BLOCK, sampleNum - begin);
+		T* src = m_layer[0].get();
+		T* dst = m_layer[1].get();
+
+		// ͑wm[hƂɕבւ
+		for (int s = 0; s < blockNum; ++s)
+		{
+			for (int i = 0; i < m_inputLayerSize; ++i)
+				src[i * blockNum + s] = input[(begin + s) * m_inputLayerSize + i];
+		}
+		if (m_format == SparseFormat::BLOCK)
+			std::fill(&src[m_inputLayerSize * blockNum], &src[roundUp(m_inputLayerSize) * blockNum], T(0));
+
+		for (const SparseLayer<T>& layer : m_layers)
+		{
+			propagate(layer, src, blockNum, dst);
+			ActFncOperator::apply(layer.actFncID, dst, layer.size * blockNum, layer.precision);
+			if (m_format == SparseFormat::BLOCK)
+				std::fill(&dst[layer.size * blockNum], &dst[roundUp(layer.size) * blockNum], T(0));
+			std::swap(src, dst);
+		}
+
+		// o͑w͂Ƃɕג
+		for (int s = 0; s < blockNum; ++s)
+		{
+			for (int i = 0; i < outputSize; ++i)
+				output[(begin + s) * outputSize + i] = src[i * blockNum + s];
+		}
+	}
+}
+
+template<typename T>
+inline void SparseNeuralNetwork<T>::toNeuralNetwork(NeuralNetwork<T>& nn) const
+{
+	nn.clear();
+	nn.setInputLayer(m_inputLayerSize);
+	nn.setHiddenLayerNum(getLayerNum() - 1);
+	for (int n = 0; n + 1 < getLayerNum(); ++n)
+		nn.setHiddenLayer(m_layers[n].size, m_layers[n].actFncID, m_layers[n].precision);
+	nn.setOutputLayer(m_layers.back().size, m_layers.back().actFncID, m_layers.back().precision);
+
+	std::vector<T> weight(nn.getWeightSize(), T(0));
+	T* dst = weight.data();
+	for (const SparseLayer<T>& layer : m_layers)
+	{
+		const int stride = layer.srcSize + 1;
+		for (int d = 0; d < layer.size; ++d)
+		{
+			T* row = &dst[d * stride];
+			for (int k = layer.rowBegin[d]; k < layer.rowBegin[d + 1]; ++k)
+			{
+				if (m_format == SparseFormat::CSR)
+				{
+					row[layer.index[k]] = layer.value[k];
+				}
+				else
+				{
+					const int end = std::min(layer.index[k] + BLOCK_SIZE, layer.srcSize);
+					for (int c = layer.index[k]; c < end; ++c)
+						row[c] = layer.value[k * BLOCK_SIZE + c - layer.index[k]];
+				}
+			}
+			row[layer.srcSize] = layer.bias[d];
+		}
+		dst += layer.size * stride;
+	}
+	nn.setWeight(weight.data());
+}
+
+template<typename T>
+inline double SparseNeuralNetwork<T>::getPruneThreshold(const NeuralNetwork<T>& nn, double sparsity)
+{
+	// oCAXd݂̐ΒlW߂
+	std::vector<double> magnitude;
+	magnitude.reserve(nn.getWeightSize());
+	const T* weight = nn.getWeight();
+	int srcSize = nn.getInputLayerSize();
+	for (int n = 0; n <= nn.getHiddenLayerNum(); ++n)
+	{
+		int size = n < nn.getHiddenLayerNum() ? nn.getHiddenLayerSize(n) : nn.getOutputLayerSize();
+		for (int d = 0; d < size; ++d)
+		{
+			for (int i = 0; i < srcSize; ++i)
+				magnitude.push_back(std::abs(static_cast<double>(weight[d * (srcSize + 1) + i])));
+		}
+		weight += size * (srcSize + 1);
+		srcSize = size;
+	}
+
+	const int64_t count = static_cast<int64_t>(std::clamp(sparsity, 0.0, 1.0) * magnitude.size());
+	if (count <= 0)
+		return -1;
+	std::nth_element(magnitude.begin(), magnitude.begin() + (count - 1), magnitude.end());
+	return magnitude[count - 1];
+}
+
+template<typename T>
+inline int SparseNeuralNetwork<T>::getInputLayerSize() const
+{
+	return m_inputLayerSize;
+}
+
+template<typename T>
+inline int SparseNeuralNetwork<T>::getOutputLayerSize() const
+{
+	return m_layers.back().size;
+}
+
+template<typename T>
+inline SparseFormat SparseNeuralNetwork<T>::getFormat() const
+{
+	return m_format;
+}
+
+template<typename T>
+inline int SparseNeuralNetwork<T>::getLayerNum() const
+{
+	return static_cast<int>(m_layers.size());
+}
+
+template<typename T>
+inline const SparseLayer<T>& SparseNeuralNetwork<T>::getLayer(int index) const
+{
+	return m_layers[index];
+}
+
+template<typename T>
+inline int64_t SparseNeuralNetwork<T>::getStoredWeightNum() const
+{
+	int64_t num = 0;
+	for (const SparseLayer<T>& layer : m_layers)
+		num += layer.value.size();
+	return num;
+}
+
+template<typename T>
+inline int64_t SparseNeuralNetwork<T>::getDenseWeightNum() const
+{
+	int64_t num = 0;
+	for (const SparseLayer<T>& layer : m_layers)
+		num += static_cast<int64_t>(layer.size) * layer.srcSize;
+	return num;
+}
+
+template<typename T>
+inline int64_t SparseNeuralNetwork<T>::getByteSize() const
+{
+	int64_t size = 0;
+	for (const SparseLayer<T>& layer : m_layers)
+	{
+		size += sizeof(int32_t) * static_cast<int64_t>(layer.rowBegin.size() + layer.index.size());
+		size += sizeof(T) * static_cast<int64_t>(layer.value.size() + layer.bias.size());
+	}
+	return size;
+}
+
+template<typename T>
+inline void SparseNeuralNetwork<T>::propagate(const SparseLayer<T>& layer, const T* src, int blockNum, T* dst) const
+{
+	// 0łȂd݂PubN̑SĂ̓͂Ɏg (s̃[v̓xNg)
+	if (m_format == SparseFormat::CSR)
+	{
+		for (int d = 0; d < layer.size; ++d)
+		{
+			T* out = &dst[d * blockNum];
+			std::fill(out, out + blockNum, layer.bias[d]);
+			for (int k = layer.rowBegin[d]; k < layer.rowBegin[d + 1]; ++k)
+			{
+				const T w = layer.value[k];
+				const T* in = &src[layer.index[k] * blockNum];
+				for (int s = 0; s < blockNum; ++s)
+					out[s] += w * in[s];
+			}
+		}
+	}
+	else
+	{
+		for (int d = 0; d < layer.size; ++d)
+		{
+			T* out = &dst[d * blockNum];
+			std::fill(out, out + blockNum, layer.bias[d]);
+			for (int k = layer.rowBegin[d]; k < layer.rowBegin[d + 1]; ++k)
+			{
+				const T* w = &layer.value[k * BLOCK_SIZE];
+				const T* in = &src[layer.index[k] * blockNum];
+				for (int c = 0; c < BLOCK_SIZE; ++c)
+				{
+					for (int s = 0; s < blockNum; ++s)
+						out[s] += w[c] * in[c * blockNum + s];
+				}
+			}
+		}
+	}
+}
+
+template<typename T>
+inline int SparseNeuralNetwork<T>::roundUp(int size)
+{
+	return (size + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+}
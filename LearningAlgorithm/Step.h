@@ -8,10 +8,43 @@ class Step : public ActivationFunction<T>
 public:
 	T operator()(T x) const override
 	{
-		return x > 0 ? 1 : 0;
+		return compute(x);
 	}
 	explicit operator ActFncID() const noexcept override
 	{
 		return ActFncID::STEP;
 	}
+
+	// z֐ȂvZ
+	static T compute(T x)
+	{
+		return x > 0 ? 1 : 0;
+	}
+
+	/*
+	* z̑SvfɓKp
+	* 
+	* @param x z (㏑)
+	* @param n vf
+	*/
+	static void apply(T* x, int n)
+	{
+		for (int i = 0; i < n; ++i)
+			x[i] = compute(x[i]);
+	}
+
+	/*
+	* z̑SvfɂĔl߂
+	* 
+	* @param x ֐KpO̒l̔z
+	* @param y ֐Kp̒l̔z
+	* @param d l̏ݐ
+	* @param n vf
+	*/
+	static void derivative(const T*, const T*, T* d, int n)
+	{
+		// l0 (x = 0ł͔s\0Ƃ)
+		for (int i = 0; i < n; ++i)
+			d[i] = 0;
+	}
 };
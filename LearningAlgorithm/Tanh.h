@@ -0,0 +1,72 @@
+#pragma once
+
+#include "ActivationFunction.h"
+#include "FastMath.h"
+#include <cmath>
+#include <type_traits>
+
+template <typename T>
+class Tanh : public ActivationFunction<T>
+{
+	static_assert(std::is_floating_point_v<T>, "Tanh template is only float or double");
+
+public:
+	T operator()(T x) const override
+	{
+		return compute(x);
+	}
+	explicit operator ActFncID() const noexcept override
+	{
+		return ActFncID::TANH;
+	}
+
+	// z֐ȂvZ
+	static T compute(T x)
+	{
+		return std::tanh(x);
+	}
+
+	/*
+	* z̑SvfɓKp
+	* 
+	* @param x         z (㏑)
+	* @param n         vf
+	* @param precision vZ̐x
+	*/
+	static void apply(T* x, int n, ActFncPrecision precision = ActFncPrecision::EXACT)
+	{
+		switch (precision)
+		{
+		case ActFncPrecision::APPROXIMATE:
+			for (int i = 0; i < n; ++i)
+				x[i] = FastMath::tanhApproximate(x[i]);
+			return;
+		case ActFncPrecision::TABLE:
+		{
+			const T* table = FastMath::getTanhTable<T>();
+			for (int i = 0; i < n; ++i)
+				x[i] = FastMath::tanhTable(x[i], table);
+			return;
+		}
+		default:
+			for (int i = 0; i < n; ++i)
+				x[i] = compute(x[i]);
+			return;
+		}
+	}
+
+	/*
+	* z̑SvfɂĔl߂
+	* 
+	* @param x ֐KpO̒l̔z
+	* @param y ֐Kp̒l̔z
+	* @param d l̏ݐ
+	* @param n vf
+	*/
+	static void derivative(const T*, const T* y, T* d, int n)
+	{
+		// tanh(x) ̔ 1 - y^2
+		for (int i = 0; i < n; ++i)
+			d[i] = T(1) - y[i] * y[i];
+	}
+};
@@ -0,0 +1,336 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <cstdint>
+
+/*
+* ゲƂ̏Ԃ̌v
+*
+* LA_TELEMETRY`ăRpCꍇ̂݁AGeneticAlgorithmNeuralNetworkv
+* `Ȃꍇ͌ṽR[hSăRpCꂸAsetTelemetry֐͉Ȃ
+*
+* g
+*     Telemetry telemetry;
+*     telemetry.setCallback([&ofs](const TelemetrySnapshot& snapshot) { Telemetry::writeJsonLine(ofs, snapshot); });
+*     ga.setTelemetry(&telemetry);
+*     nn.setTelemetry(&telemetry);
+*     (generateNextGeneration֐̏IɐゲƂ̌ʂR[obNɓn)
+*/
+
+// v鏈
+enum class TelemetryPhase
+{
+	EVALUATION,  // Kx̕] (generateNextGeneration֐̏I肩evaluate֐ĂԂ܂)
+	SORT,        // Kxɂ\[g
+	SELECTION,   // ȇI (I@̏܂)
+	CROSSOVER,   // 
+	SWAP,        // G[g̎zƐ̃obt@̓ւ
+	FORWARD      // NeuralNetwork̏`d
+};
+
+inline constexpr int TELEMETRY_PHASE_NUM = static_cast<int>(TelemetryPhase::FORWARD) + 1;
+
+/*
+* Ԃ̃qXgO
+*
+* iԖڂ̋Ԃ [2^i, 2^(i + 1)) imb (0Ԗڂ0imb܂)
+*/
+struct TelemetryHistogram
+{
+	static constexpr int BUCKET_NUM = 40;
+
+	uint64_t count[BUCKET_NUM] = {};
+
+	// @return L^
+	uint64_t getTotal() const;
+
+	/*
+	* @param p  0`1
+	* @return L^Ԃpʓ_܂ދԂ̏ (imb)
+	*/
+	int64_t getPercentile(double p) const;
+
+	// @return time
+	static int getBucket(int64_t time);
+};
+
+/*
+* P㕪̌v
+*
+* Ԃ̓imb
+* ̃Xbhōs (SELECTIONECROSSOVER) ͑SXbh̍v
+*/
+struct TelemetrySnapshot
+{
+	int generation = 0;                                // v
+	double generationTime = 0;                         // O̐̏I肩̌oߎ (b)
+	int64_t phaseTime[TELEMETRY_PHASE_NUM] = {};       // ̐̏Ƃ̎
+	int64_t phaseCount[TELEMETRY_PHASE_NUM] = {};      // ̐̏Ƃ̋L^
+	int64_t forwardSampleNum = 0;                      // ̐ɏ`d͂̐
+	double forwardPerSecond = 0;                       // ̐̂Pb̏`d͂̐
+	TelemetryHistogram histogram[TELEMETRY_PHASE_NUM]; // Ƃ̎Ԃ̃qXgO (vn߂Ă̗݌v)
+};
+
+// oߎԂ𑪂^C}[
+class TelemetryTimer
+{
+public:
+	TelemetryTimer();
+
+	// @return ܂͑Olap֐̌oߎ (imb)
+	int64_t lap();
+
+private:
+	std::chrono::steady_clock::time_point m_begin;
+};
+
+/*
+* vʂW߂NX
+*
+* record֐͕̃Xbh瓯ɌĂяo
+*/
+class Telemetry
+{
+public:
+	using Callback = std::function<void(const TelemetrySnapshot&)>;
+
+	Telemetry();
+
+	Telemetry(const Telemetry&) = delete;
+	Telemetry& operator=(const Telemetry&) = delete;
+
+public:
+	// @param callback endGeneration֐̂тɌĂ΂֐
+	void setCallback(Callback callback);
+
+	/*
+	* ԂL^
+	*
+	* @param phase 
+	* @param time   (imb)
+	*/
+	void record(TelemetryPhase phase, int64_t time);
+
+	/*
+	* `dL^
+	*
+	* @param sampleNum `d͂̐
+	* @param time       (imb)
+	*/
+	void recordForward(int64_t sampleNum, int64_t time);
+
+	/*
+	* ̏IɌĂсA̐̌vʂ܂Ƃ߂ăR[obNɓn
+	*
+	* @param generation I
+	*/
+	void endGeneration(int generation);
+
+	// @return ŌendGeneration֐ł܂Ƃ߂v
+	TelemetrySnapshot getSnapshot() const;
+
+	// vʂS0ɖ߂
+	void clear();
+
+	/*
+	* vʂJSON̂PsƂďo (JSON Lines`)
+	*
+	* @param os       o
+	* @param snapshot v
+	* @return oɐꍇtrue
+	*/
+	static bool writeJsonLine(std::ostream& os, const TelemetrySnapshot& snapshot);
+
+	// @return phase̖O (JSOÑL[)
+	static const char* toString(TelemetryPhase phase);
+
+private:
+	std::atomic<int64_t> m_phaseTime[TELEMETRY_PHASE_NUM];
+	std::atomic<int64_t> m_phaseCount[TELEMETRY_PHASE_NUM];
+	std::atomic<uint64_t> m_histogram[TELEMETRY_PHASE_NUM][TelemetryHistogram::BUCKET_NUM];
+	std::atomic<int64_t> m_forwardSampleNum;
+	TelemetryTimer m_generationTimer;
+	TelemetrySnapshot m_snapshot;
+	Callback m_callback;
+	mutable std::mutex m_mutex;
+};
+
+
+
+
+inline uint64_t TelemetryHistogram::getTotal() const
+{
+	uint64_t total = 0;
+	for (uint64_t c : count)
+		total += c;
+	return total;
+}
+
+inline int64_t TelemetryHistogram::getPercentile(double p) const
+{
+	const uint64_t total = getTotal();
+	if (total == 0)
+		return 0;
+
+	// pʓ_ԂT
+	const double target = p * total;
+	uint64_t sum = 0;
+	for (int i = 0; i < BUCKET_NUM; ++i)
+	{
+		sum += count[i];
+		if (sum >= target && count[i] > 0)
+			return int64_t(1) << (i + 1);
+	}
+	return int64_t(1) << BUCKET_NUM;
+}
+
+inline int TelemetryHistogram::getBucket(int64_t time)
+{
+	int bucket = 0;
+	while (bucket + 1 < BUCKET_NUM && (time >> (bucket + 1)) > 0)
+		++bucket;
+	return bucket;
+}
+
+inline TelemetryTimer::TelemetryTimer()
+	: m_begin(std::chrono::steady_clock::now())
+{
+}
+
+inline int64_t TelemetryTimer::lap()
+{
+	auto now = std::chrono::steady_clock::now();
+	int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_begin).count();
+	m_begin = now;
+	return time;
+}
+
+inline Telemetry::Telemetry()
+	: m_phaseTime()
+	, m_phaseCount()
+	, m_histogram()
+	, m_forwardSampleNum()
+	, m_generationTimer()
+	, m_snapshot()
+	, m_callback()
+	, m_mutex()
+{
+	clear();
+}
+
+inline void Telemetry::setCallback(Callback callback)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_callback = std::move(callback);
+}
+
+inline void Telemetry::record(TelemetryPhase phase, int64_t time)
+{
+	const int index = static_cast<int>(phase);
+	m_phaseTime[index].fetch_add(time, std::memory_order_relaxed);
+	m_phaseCount[index].fetch_add(1, std::memory_order_relaxed);
+	m_histogram[index][TelemetryHistogram::getBucket(time)].fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void Telemetry::recordForward(int64_t sampleNum, int64_t time)
+{
+	record(TelemetryPhase::FORWARD, time);
+	m_forwardSampleNum.fetch_add(sampleNum, std::memory_order_relaxed);
+}
+
+inline void Telemetry::endGeneration(int generation)
+{
+	Callback callback;
+	TelemetrySnapshot snapshot;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		// ̐̕o0ɖ߂ (qXgO͗݌v̂܂)
+		snapshot.generation = generation;
+		snapshot.generationTime = m_generationTimer.lap() * 1e-9;
+		for (int i = 0; i < TELEMETRY_PHASE_NUM; ++i)
+		{
+			snapshot.phaseTime[i] = m_phaseTime[i].exchange(0, std::memory_order_relaxed);
+			snapshot.phaseCount[i] = m_phaseCount[i].exchange(0, std::memory_order_relaxed);
+			for (int j = 0; j < TelemetryHistogram::BUCKET_NUM; ++j)
+				snapshot.histogram[i].count[j] = m_histogram[i][j].load(std::memory_order_relaxed);
+		}
+		snapshot.forwardSampleNum = m_forwardSampleNum.exchange(0, std::memory_order_relaxed);
+		if (snapshot.generationTime > 0)
+			snapshot.forwardPerSecond = snapshot.forwardSampleNum / snapshot.generationTime;
+
+		m_snapshot = snapshot;
+		callback = m_callback;
+	}
+
+	// R[obN̒getSnapshot֐Ăׂ悤ɃbN̊OŌĂ
+	if (callback)
+		callback(snapshot);
+}
+
+inline TelemetrySnapshot Telemetry::getSnapshot() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_snapshot;
+}
+
+inline void Telemetry::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (int i = 0; i < TELEMETRY_PHASE_NUM; ++i)
+	{
+		m_phaseTime[i].store(0, std::memory_order_relaxed);
+		m_phaseCount[i].store(0, std::memory_order_relaxed);
+		for (auto& count : m_histogram[i])
+			count.store(0, std::memory_order_relaxed);
+	}
+	m_forwardSampleNum.store(0, std::memory_order_relaxed);
+	m_generationTimer.lap();
+	m_snapshot = TelemetrySnapshot();
+}
+
+inline bool Telemetry::writeJsonLine(std::ostream& os, const TelemetrySnapshot& snapshot)
+{
+	os << "{\"generation\":" << snapshot.generation
+		<< ",\"generationTime\":" << snapshot.generationTime
+		<< ",\"forwardSampleNum\":" << snapshot.forwardSampleNum
+		<< ",\"forwardPerSecond\":" << snapshot.forwardPerSecond
+		<< ",\"phases\":{";
+	for (int i = 0; i < TELEMETRY_PHASE_NUM; ++i)
+	{
+		const TelemetryHistogram& histogram = snapshot.histogram[i];
+		os << (i == 0 ? "" : ",") << "\"" << toString(static_cast<TelemetryPhase>(i)) << "\":{"
+			<< "\"time\":" << snapshot.phaseTime[i]
+			<< ",\"count\":" << snapshot.phaseCount[i]
+			<< ",\"p50\":" << histogram.getPercentile(0.5)
+			<< ",\"p90\":" << histogram.getPercentile(0.9)
+			<< ",\"p99\":" << histogram.getPercentile(0.99)
+			<< "}";
+	}
+	os << "}}\n";
+	return static_cast<bool>(os);
+}
+
+inline const char* Telemetry::toString(TelemetryPhase phase)
+{
+	switch (phase)
+	{
+	case TelemetryPhase::EVALUATION:
+		return "evaluation";
+	case TelemetryPhase::SORT:
+		return "sort";
+	case TelemetryPhase::SELECTION:
+		return "selection";
+	case TelemetryPhase::CROSSOVER:
+		return "crossover";
+	case TelemetryPhase::SWAP:
+		return "swap";
+	case TelemetryPhase::FORWARD:
+		return "forward";
+	}
+	return "";
+}